@@ -0,0 +1,64 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness for AsteroidPatrolBench (no external dependencies).
+// A suite is a function registered with BENCH_SUITE; it runs its cases and
+// reports one row per measured value.
+
+class BenchReporter {
+public:
+    explicit BenchReporter(const std::string& suite) : suite_(suite) {}
+
+    void Report(const std::string& name, double value, const std::string& unit);
+
+private:
+    std::string suite_;
+};
+
+typedef void (*BenchFunction)(BenchReporter& reporter);
+
+struct BenchSuite {
+    const char* name;
+    BenchFunction function;
+};
+
+// All suites registered by BENCH_SUITE, in link order
+std::vector<BenchSuite>& GetBenchSuites();
+
+struct BenchRegistrar {
+    BenchRegistrar(const char* name, BenchFunction function) {
+        GetBenchSuites().push_back(BenchSuite{name, function});
+    }
+};
+
+#define BENCH_SUITE(name)                                            \
+    static void name(BenchReporter& reporter);                       \
+    static BenchRegistrar name##_registrar(#name, name);             \
+    static void name(BenchReporter& reporter)
+
+// Run body repeatedly until at least min_seconds have elapsed and return the
+// average seconds per call
+template <typename Body>
+double MeasureSeconds(Body body, double min_seconds = 0.2) {
+    typedef std::chrono::steady_clock Clock;
+    body();  // Warm up caches and lazily grown buffers
+
+    size_t iterations = 0;
+    Clock::time_point start = Clock::now();
+    double elapsed = 0.0;
+    do {
+        body();
+        iterations++;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    } while (elapsed < min_seconds);
+    return elapsed / static_cast<double>(iterations);
+}
+
+// Keep the optimizer from discarding results that are otherwise unused
+void DoNotOptimize(size_t value);
+
+#endif // BENCH_H
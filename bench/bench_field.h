@@ -0,0 +1,69 @@
+#ifndef BENCH_FIELD_H
+#define BENCH_FIELD_H
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Synthetic asteroid fields for the collision benchmarks. Density is kept
+// constant (about the density of the default 15-asteroid field), so larger
+// fields are larger volumes rather than more crowded ones.
+
+const float BENCH_VOLUME_PER_ASTEROID = 4000.0f;
+
+struct BenchField {
+    std::vector<glm::vec3> centers;
+    std::vector<float> radii;
+    float extent;  // Half size of the cube holding the field
+};
+
+// A projectile segment: the distance a laser covers in one 60 Hz tick
+struct BenchSegment {
+    glm::vec3 start;
+    glm::vec3 end;
+    glm::vec3 direction;
+};
+
+inline BenchField MakeBenchField(size_t count, unsigned int seed = 1234) {
+    BenchField field;
+    field.extent = 0.5f * std::cbrt(static_cast<float>(count) * BENCH_VOLUME_PER_ASTEROID);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-field.extent, field.extent);
+    std::uniform_real_distribution<float> radius(1.0f, 3.0f);
+
+    field.centers.reserve(count);
+    field.radii.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        field.centers.push_back(glm::vec3(position(rng), position(rng), position(rng)));
+        field.radii.push_back(radius(rng));
+    }
+    return field;
+}
+
+inline std::vector<BenchSegment> MakeBenchSegments(const BenchField& field, size_t count,
+                                                    float length, unsigned int seed = 5678) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-field.extent, field.extent);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+
+    std::vector<BenchSegment> segments;
+    segments.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        glm::vec3 direction;
+        do {
+            direction = glm::vec3(axis(rng), axis(rng), axis(rng));
+        } while (glm::dot(direction, direction) < 0.01f);
+        direction = glm::normalize(direction);
+
+        BenchSegment segment;
+        segment.start = glm::vec3(position(rng), position(rng), position(rng));
+        segment.end = segment.start + direction * length;
+        segment.direction = direction;
+        segments.push_back(segment);
+    }
+    return segments;
+}
+
+#endif // BENCH_FIELD_H
@@ -0,0 +1,47 @@
+/* AsteroidPatrolBench - micro-benchmarks for the game's CPU-side systems.
+ *
+ * Usage: AsteroidPatrolBench [suite-filter]
+ *   Runs every suite whose name contains the filter (all suites by default)
+ *   and prints one table row per measurement.
+ */
+
+#include "bench.h"
+#include <cstdio>
+#include <iostream>
+
+std::vector<BenchSuite>& GetBenchSuites() {
+    static std::vector<BenchSuite> suites;
+    return suites;
+}
+
+void BenchReporter::Report(const std::string& name, double value, const std::string& unit) {
+    std::printf("%-24s %-40s %14.2f  %s\n", suite_.c_str(), name.c_str(), value, unit.c_str());
+    std::fflush(stdout);
+}
+
+static volatile size_t g_sink = 0;
+
+void DoNotOptimize(size_t value) {
+    g_sink = g_sink + value;
+}
+
+int main(int argc, char** argv) {
+    std::string filter = argc > 1 ? argv[1] : "";
+
+    std::printf("%-24s %-40s %14s  %s\n", "suite", "case", "value", "unit");
+    int run = 0;
+    for (const auto& suite : GetBenchSuites()) {
+        if (!filter.empty() && std::string(suite.name).find(filter) == std::string::npos) {
+            continue;
+        }
+        BenchReporter reporter(suite.name);
+        suite.function(reporter);
+        run++;
+    }
+
+    if (run == 0) {
+        std::cerr << "No benchmark suite matches '" << filter << "'" << std::endl;
+        return 1;
+    }
+    return 0;
+}
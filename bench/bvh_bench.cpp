@@ -0,0 +1,123 @@
+#include "bench.h"
+#include "bench_field.h"
+#include "collision.h"
+#include "dynamic_bvh.h"
+#include <random>
+#include <string>
+
+// Dynamic BVH maintenance and query costs. Closest-hit ray casts are compared
+// against a brute-force scan of every sphere, which is what the game would
+// otherwise need to find the first asteroid a projectile reaches.
+
+static const size_t FIELD_SIZES[] = {1000, 10000, 100000};
+static const size_t QUERY_COUNT = 256;
+static const float RAY_LENGTH = 200.0f;     // Laser range over its lifetime
+static const float DRIFT_DISTANCE = 0.15f;  // Asteroid movement per tick (9 units/s at 60 Hz)
+static const float QUERY_RADIUS = 1.5f;     // Ship collision radius
+static const size_t NEAREST_COUNT = 8;
+
+BENCH_SUITE(collision_bvh) {
+    for (size_t count : FIELD_SIZES) {
+        BenchField field = MakeBenchField(count);
+        std::vector<BenchSegment> rays = MakeBenchSegments(field, QUERY_COUNT, RAY_LENGTH);
+        std::string label = std::to_string(count) + " asteroids";
+
+        DynamicBvh tree;
+        std::vector<int> proxies(count);
+        double insert = MeasureSeconds([&]() {
+            tree.Clear();
+            for (size_t i = 0; i < count; i++) {
+                proxies[i] = tree.CreateProxy(field.centers[i], field.radii[i], static_cast<int>(i));
+            }
+        });
+        reporter.Report("insert, " + label, insert * 1e9 / count, "ns/proxy");
+        reporter.Report("tree height, " + label, tree.GetHeight(), "levels");
+
+        // Move every asteroid a small random step, as one simulation tick would.
+        // Each pass rotates through the step table, so asteroids random-walk
+        // instead of drifting steadily out of the field.
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+        std::vector<glm::vec3> steps(count);
+        for (auto& step : steps) {
+            step = glm::vec3(axis(rng), axis(rng), axis(rng)) * DRIFT_DISTANCE;
+        }
+        size_t reinserted = 0;
+        size_t move_calls = 0;
+        size_t pass = 0;
+        double move = MeasureSeconds([&]() {
+            pass++;
+            for (size_t i = 0; i < count; i++) {
+                field.centers[i] += steps[(i + pass * 7919) % count];
+                reinserted += tree.MoveProxy(proxies[i], field.centers[i], field.radii[i]);
+            }
+            move_calls += count;
+        });
+        reporter.Report("move/refit, " + label, move * 1e9 / count, "ns/proxy");
+        reporter.Report("reinserted, " + label, 100.0 * reinserted / move_calls, "% of moves");
+
+        size_t tree_hits = 0;
+        double ray_tree = MeasureSeconds([&]() {
+            tree_hits = 0;
+            for (const auto& ray : rays) {
+                BvhHit hit;
+                tree_hits += tree.RayCast(ray.start, ray.direction, RAY_LENGTH, hit);
+            }
+        });
+        reporter.Report("closest ray (bvh), " + label, ray_tree * 1e9 / QUERY_COUNT, "ns/ray");
+
+        size_t brute_hits = 0;
+        double ray_brute = MeasureSeconds([&]() {
+            brute_hits = 0;
+            for (const auto& ray : rays) {
+                float best = RAY_LENGTH;
+                bool found = false;
+                for (size_t i = 0; i < count; i++) {
+                    float distance;
+                    if (RaySphereDistance(ray.start, ray.direction, field.centers[i], field.radii[i],
+                                          best, distance)) {
+                        best = distance;
+                        found = true;
+                    }
+                }
+                brute_hits += found;
+            }
+        });
+        reporter.Report("closest ray (brute force), " + label, ray_brute * 1e9 / QUERY_COUNT, "ns/ray");
+        if (tree_hits != brute_hits) {
+            reporter.Report("HIT MISMATCH, " + label, static_cast<double>(tree_hits) - brute_hits, "rays");
+        }
+
+        std::vector<int> overlaps;
+        double sphere = MeasureSeconds([&]() {
+            for (const auto& ray : rays) {
+                overlaps.clear();
+                tree.QuerySphere(ray.start, QUERY_RADIUS, overlaps);
+                DoNotOptimize(overlaps.size());
+            }
+        });
+        reporter.Report("sphere query, " + label, sphere * 1e9 / QUERY_COUNT, "ns/query");
+
+        std::vector<BvhHit> nearest;
+        double knn = MeasureSeconds([&]() {
+            for (const auto& ray : rays) {
+                nearest.clear();
+                tree.QueryNearest(ray.start, NEAREST_COUNT, nearest);
+                DoNotOptimize(nearest.size());
+            }
+        });
+        reporter.Report("8 nearest, " + label, knn * 1e9 / QUERY_COUNT, "ns/query");
+
+        double remove = MeasureSeconds([&]() {
+            DynamicBvh scratch;
+            std::vector<int> ids(count);
+            for (size_t i = 0; i < count; i++) {
+                ids[i] = scratch.CreateProxy(field.centers[i], field.radii[i], static_cast<int>(i));
+            }
+            for (size_t i = 0; i < count; i++) {
+                scratch.DestroyProxy(ids[i]);
+            }
+        });
+        reporter.Report("insert+remove, " + label, remove * 1e9 / count, "ns/proxy");
+    }
+}
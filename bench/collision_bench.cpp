@@ -0,0 +1,103 @@
+#include "bench.h"
+#include "bench_field.h"
+#include "collision.h"
+#include "spatial_hash.h"
+#include <algorithm>
+#include <string>
+
+// Broadphase cost per projectile as the field grows at constant density:
+// brute force grows linearly with the asteroid count, the spatial hash should
+// stay roughly flat.
+
+static const size_t FIELD_SIZES[] = {15, 100, 1000, 10000, 100000};
+static const size_t PROJECTILE_COUNT = 64;
+static const float LASER_TICK_LENGTH = 50.0f / 60.0f;  // Laser speed * 60 Hz tick
+static const float LASER_HALF_LENGTH = 2.5f;           // Half the beam length
+static const float GRID_CELL_SIZE = 8.0f;
+
+BENCH_SUITE(collision_broadphase) {
+    for (size_t count : FIELD_SIZES) {
+        BenchField field = MakeBenchField(count);
+        std::vector<BenchSegment> segments = MakeBenchSegments(field, PROJECTILE_COUNT, LASER_TICK_LENGTH);
+        std::string label = std::to_string(count) + " asteroids";
+
+        SpatialHash grid(GRID_CELL_SIZE);
+        double build = MeasureSeconds([&]() {
+            grid.Clear();
+            for (size_t i = 0; i < count; i++) {
+                grid.Insert(static_cast<int>(i), field.centers[i], field.radii[i]);
+            }
+            grid.Build();
+        });
+        reporter.Report("grid rebuild, " + label, build * 1e9 / count, "ns/asteroid");
+
+        std::vector<int> candidates;
+        size_t candidate_total = 0;
+        double grid_query = MeasureSeconds([&]() {
+            size_t hits = 0;
+            candidate_total = 0;
+            for (const auto& segment : segments) {
+                candidates.clear();
+                grid.QuerySegment(segment.start, segment.end, LASER_HALF_LENGTH, candidates);
+                candidate_total += candidates.size();
+                for (int index : candidates) {
+                    hits += RayIntersectsSphere(segment.start, segment.direction,
+                                                field.centers[index], field.radii[index]);
+                }
+            }
+            DoNotOptimize(hits);
+        });
+        reporter.Report("grid query+test, " + label, grid_query * 1e9 / PROJECTILE_COUNT, "ns/projectile");
+        reporter.Report("grid candidates, " + label,
+                        static_cast<double>(candidate_total) / PROJECTILE_COUNT, "per projectile");
+
+        // Continuous test over the swept beam, keeping the earliest impact
+        size_t swept_hits = 0;
+        double grid_swept = MeasureSeconds([&]() {
+            swept_hits = 0;
+            for (const auto& segment : segments) {
+                glm::vec3 sweep_start = segment.start - segment.direction * LASER_HALF_LENGTH;
+                glm::vec3 sweep_end = segment.end + segment.direction * LASER_HALF_LENGTH;
+                candidates.clear();
+                grid.QuerySegment(segment.start, segment.end, LASER_HALF_LENGTH, candidates);
+                float closest = 2.0f;
+                for (int index : candidates) {
+                    float time_of_impact;
+                    if (SegmentSphereTimeOfImpact(sweep_start, sweep_end, field.centers[index],
+                                                  field.radii[index], time_of_impact)) {
+                        closest = std::min(closest, time_of_impact);
+                    }
+                }
+                swept_hits += closest <= 1.0f;
+            }
+        });
+
+        // The line test also reports asteroids behind or beyond the beam
+        size_t line_hits = 0;
+        for (const auto& segment : segments) {
+            candidates.clear();
+            grid.QuerySegment(segment.start, segment.end, LASER_HALF_LENGTH, candidates);
+            bool line_hit = false;
+            for (int index : candidates) {
+                line_hit |= RayIntersectsSphere(segment.end, segment.direction,
+                                                field.centers[index], field.radii[index]);
+            }
+            line_hits += line_hit;
+        }
+        reporter.Report("grid query+swept test, " + label, grid_swept * 1e9 / PROJECTILE_COUNT, "ns/projectile");
+        reporter.Report("line test hits, " + label, static_cast<double>(line_hits), "projectiles");
+        reporter.Report("swept test hits, " + label, static_cast<double>(swept_hits), "projectiles");
+
+        double brute = MeasureSeconds([&]() {
+            size_t hits = 0;
+            for (const auto& segment : segments) {
+                for (size_t i = 0; i < count; i++) {
+                    hits += RayIntersectsSphere(segment.start, segment.direction,
+                                                field.centers[i], field.radii[i]);
+                }
+            }
+            DoNotOptimize(hits);
+        });
+        reporter.Report("brute force, " + label, brute * 1e9 / PROJECTILE_COUNT, "ns/projectile");
+    }
+}
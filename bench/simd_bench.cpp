@@ -0,0 +1,77 @@
+#include "bench.h"
+#include "bench_field.h"
+#include "collision.h"
+#include "collision_simd.h"
+#include <string>
+
+// Batched segment-vs-sphere throughput at each SIMD level the CPU supports,
+// against the per-asteroid loop over glm::vec3 centers used before. Every
+// level must report exactly the hits and impact times of the scalar kernel.
+
+static const size_t FIELD_SIZES[] = {1000, 10000, 100000};
+static const size_t SEGMENT_COUNT = 16;
+static const float SEGMENT_LENGTH = 200.0f;  // Long segments, so some actually hit
+static const SimdLevel LEVELS[] = {SimdLevel::SCALAR, SimdLevel::SSE2, SimdLevel::AVX2};
+
+BENCH_SUITE(collision_simd) {
+    for (size_t count : FIELD_SIZES) {
+        BenchField field = MakeBenchField(count);
+        std::vector<BenchSegment> segments = MakeBenchSegments(field, SEGMENT_COUNT, SEGMENT_LENGTH);
+        std::string label = std::to_string(count) + " spheres";
+        double tests = static_cast<double>(count * SEGMENT_COUNT);
+
+        SphereArrays spheres;
+        for (size_t i = 0; i < count; i++) {
+            spheres.Add(field.centers[i], field.radii[i], static_cast<int>(i));
+        }
+
+        double aos = MeasureSeconds([&]() {
+            size_t hits = 0;
+            for (const auto& segment : segments) {
+                for (size_t i = 0; i < count; i++) {
+                    float time_of_impact;
+                    hits += SegmentSphereTimeOfImpact(segment.start, segment.end, field.centers[i],
+                                                      field.radii[i], time_of_impact);
+                }
+            }
+            DoNotOptimize(hits);
+        });
+        reporter.Report("scalar AoS loop, " + label, tests / aos * 1e-6, "Mspheres/s");
+
+        // Reference results for the mismatch check
+        std::vector<std::vector<uint32_t>> reference_masks(SEGMENT_COUNT);
+        std::vector<std::vector<float>> reference_times(SEGMENT_COUNT);
+        for (size_t s = 0; s < SEGMENT_COUNT; s++) {
+            SegmentSphereBatch(SimdLevel::SCALAR, spheres, segments[s].start, segments[s].end,
+                               reference_masks[s], reference_times[s]);
+        }
+
+        std::vector<uint32_t> hit_mask;
+        std::vector<float> time_of_impact;
+        for (SimdLevel level : LEVELS) {
+            if (!IsSimdLevelSupported(level)) continue;
+            std::string name = GetSimdLevelName(level);
+
+            double batch = MeasureSeconds([&]() {
+                size_t hits = 0;
+                for (const auto& segment : segments) {
+                    hits += SegmentSphereBatch(level, spheres, segment.start, segment.end, hit_mask, time_of_impact);
+                }
+                DoNotOptimize(hits);
+            });
+            reporter.Report(name + " batch, " + label, tests / batch * 1e-6, "Mspheres/s");
+
+            size_t mismatches = 0;
+            for (size_t s = 0; s < SEGMENT_COUNT; s++) {
+                SegmentSphereBatch(level, spheres, segments[s].start, segments[s].end, hit_mask, time_of_impact);
+                mismatches += hit_mask != reference_masks[s];
+                for (size_t i = 0; i < count; i++) {
+                    mismatches += time_of_impact[i] != reference_times[s][i];
+                }
+            }
+            if (mismatches > 0) {
+                reporter.Report(name + " MISMATCH, " + label, static_cast<double>(mismatches), "results");
+            }
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include "bench.h"
+#include "simulation.h"
+#include "job_system.h"
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Simulation step throughput on a large-field stress scene at 1..N threads.
+// The ship sits in a 100k asteroid field turning and firing every tick, so
+// about 180 lasers and 60 missiles are in flight. Every thread count must end
+// with exactly the state of the single-threaded run.
+
+static const int ASTEROID_COUNT = 100000;
+static const int WARMUP_TICKS = 180;  // Fill the projectile pools
+static const int MEASURED_TICKS = 120;
+static const int MISSILE_INTERVAL = 3;
+static const float FIXED_STEP = 1.0f / 60.0f;
+static const uint64_t RUN_SEED = 7;
+
+struct StressResult {
+    double seconds;
+    uint64_t signature;  // Score, events, tests and destroyed asteroids
+};
+
+static StressResult RunStressScene(Broadphase broadphase, unsigned int threads) {
+    GameManager game;
+    JobSystem jobs(threads);
+    Simulation simulation(&game, &jobs, RUN_SEED);
+    simulation.broadphase = broadphase;
+    simulation.laser_capacity = 256;
+    simulation.missile_capacity = 128;
+    simulation.CreateWorld(ASTEROID_COUNT);
+    game.current_state = GameState::PLAYING;  // StartGame() would print
+
+    glm::quat turn = glm::angleAxis(0.4f * FIXED_STEP, glm::vec3(0.0f, 1.0f, 0.0f));
+    uint64_t signature = 1469598103934665603ull;
+    auto mix = [&signature](uint64_t value) { signature = (signature ^ value) * 1099511628211ull; };
+
+    StressResult result;
+    std::chrono::steady_clock::time_point start;
+    for (int tick = 0; tick < WARMUP_TICKS + MEASURED_TICKS; tick++) {
+        if (tick == WARMUP_TICKS) {
+            start = std::chrono::steady_clock::now();
+        }
+        simulation.ship_transform.orientation = turn * simulation.ship_transform.orientation;
+        simulation.FireLaser();
+        if (tick % MISSILE_INTERVAL == 0) {
+            simulation.FireMissile();
+        }
+        simulation.Step(FIXED_STEP);
+        mix(simulation.events.size());
+        mix(simulation.collision_tests);
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    mix(static_cast<uint64_t>(game.score));
+    for (size_t i = 0; i < simulation.asteroids.GetCount(); i++) {
+        if (!simulation.asteroids.live[i]) {
+            mix(i);
+        }
+    }
+    result.signature = signature;
+    return result;
+}
+
+BENCH_SUITE(simulation_threads) {
+    unsigned int max_threads = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<unsigned int> thread_counts;
+    for (unsigned int threads = 1; threads < max_threads; threads *= 2) {
+        thread_counts.push_back(threads);
+    }
+    thread_counts.push_back(max_threads);
+
+    const Broadphase BROADPHASES[] = {Broadphase::GRID, Broadphase::BVH, Broadphase::BRUTE_FORCE};
+    for (Broadphase broadphase : BROADPHASES) {
+        std::string label = std::string(GetBroadphaseName(broadphase)) + ", ";
+        StressResult serial = RunStressScene(broadphase, 1);
+        double serial_rate = MEASURED_TICKS / serial.seconds;
+        reporter.Report(label + "1 thread", serial_rate, "ticks/s");
+
+        for (unsigned int threads : thread_counts) {
+            if (threads == 1) continue;
+            StressResult parallel = RunStressScene(broadphase, threads);
+            double rate = MEASURED_TICKS / parallel.seconds;
+            std::string name = label + std::to_string(threads) + " threads";
+            reporter.Report(name, rate, "ticks/s");
+            reporter.Report(name + " speedup", rate / serial_rate, "x");
+            if (parallel.signature != serial.signature) {
+                reporter.Report(name + " MISMATCH", 1.0, "state differs from 1 thread");
+            }
+        }
+    }
+}
@@ -0,0 +1,169 @@
+#include "bench.h"
+#include "transform_simd.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+
+// Batch transform kernels at each SIMD level the CPU supports, against the
+// per-object glm code they replace: q * rotation, mat4_cast for a forward
+// vector, translate * mat4_cast * scale, and transpose(inverse(world)) for
+// the normal matrix. Results must match the glm path to within rounding.
+
+static const size_t OBJECT_COUNTS[] = {1000, 100000};
+static const SimdLevel LEVELS[] = {SimdLevel::SCALAR, SimdLevel::SSE2};  // AVX2 runs the SSE2 kernels
+static const float TOLERANCE = 1e-4f;
+
+struct BenchPoses {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> orientations;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::mat4> worlds;
+};
+
+static BenchPoses MakeBenchPoses(size_t count, unsigned int seed = 4321) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> axis(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.2f, 5.0f);
+
+    BenchPoses poses;
+    for (size_t i = 0; i < count; i++) {
+        glm::vec4 q;
+        do {
+            q = glm::vec4(axis(rng), axis(rng), axis(rng), axis(rng));
+        } while (glm::dot(q, q) < 0.01f);
+        q = glm::normalize(q);
+        poses.positions.push_back(glm::vec3(position(rng), position(rng), position(rng)));
+        poses.orientations.push_back(glm::quat(q.w, q.x, q.y, q.z));
+        poses.scales.push_back(glm::vec3(scale(rng), scale(rng), scale(rng)));
+        poses.worlds.push_back(ComposeTrs(poses.positions[i], poses.orientations[i], poses.scales[i]));
+    }
+    return poses;
+}
+
+// Difference relative to the size of the expected value (absolute near zero)
+static float RelativeError(float value, float expected) {
+    return std::fabs(value - expected) / std::max(1.0f, std::fabs(expected));
+}
+
+static size_t CountMismatches(const std::vector<glm::quat>& values, const std::vector<glm::quat>& expected) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        for (int c = 0; c < 4; c++) {
+            mismatches += RelativeError(values[i][c], expected[i][c]) > TOLERANCE;
+        }
+    }
+    return mismatches;
+}
+
+static size_t CountMismatches(const std::vector<glm::vec3>& values, const std::vector<glm::vec3>& expected) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        for (int c = 0; c < 3; c++) {
+            mismatches += RelativeError(values[i][c], expected[i][c]) > TOLERANCE;
+        }
+    }
+    return mismatches;
+}
+
+// Compares the upper size x size block: 3 for normal matrices, whose fourth
+// row glm fills with the inverse translation and the kernels leave at zero
+static size_t CountMismatches(const std::vector<glm::mat4>& values, const std::vector<glm::mat4>& expected,
+                              int size) {
+    size_t mismatches = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        for (int column = 0; column < size; column++) {
+            for (int row = 0; row < size; row++) {
+                mismatches += RelativeError(values[i][column][row], expected[i][column][row]) > TOLERANCE;
+            }
+        }
+    }
+    return mismatches;
+}
+
+BENCH_SUITE(transform_simd) {
+    for (size_t count : OBJECT_COUNTS) {
+        BenchPoses poses = MakeBenchPoses(count);
+        std::string label = std::to_string(count) + " objects";
+        double objects = static_cast<double>(count);
+        glm::quat rotation = glm::angleAxis(0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+
+        std::vector<glm::quat> quats(count);
+        std::vector<glm::vec3> forwards(count);
+        std::vector<glm::mat4> matrices(count);
+        std::vector<glm::quat> reference_quats(count);
+        std::vector<glm::vec3> reference_forwards(count);
+        std::vector<glm::mat4> reference_trs(count);
+        std::vector<glm::mat4> reference_normals(count);
+
+        // Per-object glm path; its results are the reference for the kernels
+        double glm_multiply = MeasureSeconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                reference_quats[i] = poses.orientations[i] * rotation;
+            }
+        });
+        reporter.Report("glm quat multiply, " + label, objects / glm_multiply * 1e-6, "Mobjects/s");
+
+        double glm_forward = MeasureSeconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                glm::mat4 orientation_mat = glm::mat4_cast(poses.orientations[i]);
+                reference_forwards[i] = glm::vec3(orientation_mat * glm::vec4(0.0f, 0.0f, -1.0f, 0.0f));
+            }
+        });
+        reporter.Report("glm mat4_cast forward, " + label, objects / glm_forward * 1e-6, "Mobjects/s");
+
+        double glm_trs = MeasureSeconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                glm::mat4 local = glm::translate(glm::mat4(1.0f), poses.positions[i]);
+                local = local * glm::mat4_cast(poses.orientations[i]);
+                reference_trs[i] = glm::scale(local, poses.scales[i]);
+            }
+        });
+        reporter.Report("glm TRS, " + label, objects / glm_trs * 1e-6, "Mobjects/s");
+
+        double glm_normal = MeasureSeconds([&]() {
+            for (size_t i = 0; i < count; i++) {
+                reference_normals[i] = glm::transpose(glm::inverse(poses.worlds[i]));
+            }
+        });
+        reporter.Report("glm inverse normal matrix, " + label, objects / glm_normal * 1e-6, "Mobjects/s");
+
+        for (SimdLevel level : LEVELS) {
+            if (!IsSimdLevelSupported(level)) continue;
+            std::string name = GetSimdLevelName(level);
+            size_t mismatches = 0;
+
+            double multiply = MeasureSeconds([&]() {
+                MultiplyQuatsBatch(level, poses.orientations.data(), rotation, quats.data(), count);
+            });
+            reporter.Report(name + " quat multiply, " + label, objects / multiply * 1e-6, "Mobjects/s");
+            mismatches += CountMismatches(quats, reference_quats);
+
+            double forward = MeasureSeconds([&]() {
+                QuatForwardBatch(level, poses.orientations.data(), forwards.data(), count);
+            });
+            reporter.Report(name + " forward, " + label, objects / forward * 1e-6, "Mobjects/s");
+            mismatches += CountMismatches(forwards, reference_forwards);
+
+            double trs = MeasureSeconds([&]() {
+                ComposeTrsBatch(level, poses.positions.data(), poses.orientations.data(), poses.scales.data(),
+                                matrices.data(), count);
+            });
+            reporter.Report(name + " TRS, " + label, objects / trs * 1e-6, "Mobjects/s");
+            mismatches += CountMismatches(matrices, reference_trs, 4);
+
+            double normal = MeasureSeconds([&]() {
+                AffineNormalMatrixBatch(level, poses.worlds.data(), matrices.data(), count);
+            });
+            reporter.Report(name + " affine normal matrix, " + label, objects / normal * 1e-6, "Mobjects/s");
+            mismatches += CountMismatches(matrices, reference_normals, 3);
+
+            if (mismatches > 0) {
+                reporter.Report(name + " MISMATCH, " + label, static_cast<double>(mismatches), "results");
+            }
+        }
+    }
+}
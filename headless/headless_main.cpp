@@ -0,0 +1,175 @@
+/* AsteroidPatrolHeadless - runs the game simulation without a window or GPU.
+ *
+ * A scripted pilot flies the ship in a wide turn, firing lasers and missiles
+ * at a fixed cadence, and the simulation is stepped as fast as the CPU
+ * allows. Through a streamed field the pilot flies straight ahead instead,
+ * so new chunks keep loading. A new game starts whenever the ship is
+ * destroyed. Useful for profiling the gameplay code and for comparing
+ * collision settings on machines without OpenGL.
+ *
+ * Usage: AsteroidPatrolHeadless [options]
+ *   --asteroids N              - Number of asteroids in the field (default 15)
+ *   --streamed                 - Stream a chunked field around the ship instead of the rings
+ *   --ticks N                  - Simulation steps to run (default 36000)
+ *   --tick-rate N              - Simulation steps per second (default 60)
+ *   --broadphase grid|bvh|brute - Collision broadphase (default grid)
+ *   --line                     - Use the infinite-line projectile test instead of swept collision
+ *   --seed N                   - Run seed for the asteroid field (decimal or 0x hex)
+ *   --threads N                - Threads for simulation jobs (default: one per hardware thread)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "simulation.h"
+#include "random.h"
+#include "job_system.h"
+
+// Scripted pilot cadence, in ticks
+const int LASER_INTERVAL = 8;
+const int MISSILE_INTERVAL = 45;
+const float TURN_RATE = 0.4f;  // Radians per second of yaw
+
+int main(int argc, char** argv) {
+    try {
+        int asteroid_count = 15;
+        long long tick_count = 36000;
+        int tick_rate = 60;
+        Broadphase broadphase = Broadphase::GRID;
+        bool use_swept_collision = true;
+        uint64_t run_seed = DEFAULT_RUN_SEED;
+        unsigned int thread_count = 0;
+        bool streamed = false;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--asteroids" && i + 1 < argc) {
+                asteroid_count = std::max(1, std::atoi(argv[++i]));
+            } else if (arg == "--streamed") {
+                streamed = true;
+            } else if (arg == "--ticks" && i + 1 < argc) {
+                tick_count = std::max(1LL, std::atoll(argv[++i]));
+            } else if (arg == "--tick-rate" && i + 1 < argc) {
+                tick_rate = std::max(1, std::atoi(argv[++i]));
+            } else if (arg == "--broadphase" && i + 1 < argc) {
+                std::string name = argv[++i];
+                if (name == "grid") {
+                    broadphase = Broadphase::GRID;
+                } else if (name == "bvh") {
+                    broadphase = Broadphase::BVH;
+                } else if (name == "brute") {
+                    broadphase = Broadphase::BRUTE_FORCE;
+                } else {
+                    throw(std::runtime_error("Unknown broadphase: " + name));
+                }
+            } else if (arg == "--line") {
+                use_swept_collision = false;
+            } else if (arg == "--seed" && i + 1 < argc) {
+                run_seed = ParseSeed(argv[++i]);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                thread_count = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+            } else {
+                throw(std::runtime_error("Unknown argument: " + arg));
+            }
+        }
+        float fixed_step = 1.0f / static_cast<float>(tick_rate);
+
+        GameManager game;
+        JobSystem jobs(thread_count);
+        Simulation simulation(&game, &jobs, run_seed);
+        simulation.broadphase = broadphase;
+        simulation.use_swept_collision = use_swept_collision;
+        simulation.field_layout = streamed ? FieldLayout::STREAMED : FieldLayout::RINGS;
+        simulation.CreateWorld(asteroid_count);
+        game.StartGame();
+
+        std::cout << "Headless: ";
+        if (streamed) {
+            std::cout << "streamed field (" << simulation.asteroids.GetCount() << " asteroid rows), ";
+        } else {
+            std::cout << asteroid_count << " asteroids, ";
+        }
+        std::cout << tick_count << " ticks at "
+                  << tick_rate << " Hz, broadphase " << GetBroadphaseName(broadphase)
+                  << (use_swept_collision ? ", swept" : ", line") << ", SIMD "
+                  << GetSimdLevelName(simulation.simd_level) << ", seed " << run_seed
+                  << ", " << jobs.GetThreadCount() << " threads" << std::endl;
+
+        // Through a streamed field the pilot flies straight, so new chunks keep loading
+        glm::quat turn = glm::angleAxis(streamed ? 0.0f : TURN_RATE * fixed_step, glm::vec3(0.0f, 1.0f, 0.0f));
+        int games = 1;
+        long long total_score = 0;
+        long long total_events = 0;
+        unsigned long long total_tests = 0;
+        double detect_microseconds = 0.0;
+        double resolve_microseconds = 0.0;
+        double reset_microseconds = 0.0;
+        size_t chunk_loads = 0;
+        double generate_microseconds = 0.0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (long long tick = 0; tick < tick_count; tick++) {
+            if (game.current_state == GameState::GAME_OVER) {
+                total_score += game.score;
+                std::chrono::steady_clock::time_point reset_start = std::chrono::steady_clock::now();
+                simulation.ResetWorld();
+                reset_microseconds += std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - reset_start).count();
+                game.StartGame();
+                games++;
+            }
+
+            simulation.ship_motion.moving_forward = true;
+            simulation.ship_transform.orientation = turn * simulation.ship_transform.orientation;
+            if (tick % LASER_INTERVAL == 0) {
+                simulation.FireLaser();
+            }
+            if (tick % MISSILE_INTERVAL == 0) {
+                simulation.FireMissile();
+            }
+
+            size_t chunks_generated = simulation.field.GetChunksGenerated();
+            simulation.Step(fixed_step);
+            if (simulation.field.GetChunksGenerated() != chunks_generated) {
+                chunk_loads++;
+                generate_microseconds += simulation.field_generate_microseconds;
+            }
+            total_events += static_cast<long long>(simulation.events.size());
+            total_tests += simulation.collision_tests;
+            detect_microseconds += simulation.detect_microseconds;
+            resolve_microseconds += simulation.resolve_microseconds;
+        }
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        total_score += game.score;
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        double ticks = static_cast<double>(tick_count);
+        std::cout << "ticks/s " << (ticks / seconds)
+                  << " | simulated " << (ticks * fixed_step) << " s in " << seconds << " s"
+                  << " | games " << games
+                  << " | score " << total_score
+                  << " | events " << total_events
+                  << " | tests/tick " << (static_cast<double>(total_tests) / ticks)
+                  << " | detect " << (detect_microseconds / ticks) << " us"
+                  << " | resolve " << (resolve_microseconds / ticks) << " us";
+        if (games > 1) {
+            std::cout << " | restart " << (reset_microseconds / (games - 1)) << " us";
+        }
+        if (streamed) {
+            std::cout << " | chunks " << simulation.field.GetResidentCount() << " resident, "
+                      << simulation.field.GetChunksGenerated() << " generated"
+                      << " | chunk load " << (chunk_loads > 0 ? generate_microseconds / chunk_loads : 0.0) << " us";
+        }
+        std::cout << std::endl;
+    }
+    catch (std::exception &e) {
+        std::cerr << "ERROR: " << e.what() << std::endl;
+        return -1;
+    }
+
+    return 0;
+}
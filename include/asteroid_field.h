@@ -0,0 +1,110 @@
+#ifndef ASTEROID_FIELD_H
+#define ASTEROID_FIELD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include "components.h"
+
+// Integer coordinate of a cubic chunk; chunk (x, y, z) covers
+// [x, x + 1) * chunk_size along X, and likewise for Y and Z
+struct ChunkCoord {
+    int x;
+    int y;
+    int z;
+
+    bool operator==(const ChunkCoord& other) const { return x == other.x && y == other.y && z == other.z; }
+    bool operator!=(const ChunkCoord& other) const { return !(*this == other); }
+};
+
+// Tuning for a streamed field; set before Simulation::CreateWorld()
+struct ChunkFieldSettings {
+    float chunk_size;           // Edge length of a chunk
+    int load_radius;            // Chunks loaded around the ship's chunk along each axis
+    int min_asteroids;          // Asteroids per chunk, drawn per chunk from [min, max]
+    int max_asteroids;
+    float spawn_clearance;      // No asteroid this close to the origin, where the ship starts
+    int chunks_per_step;        // Most chunks a step generates; the rest wait, nearest first
+
+    ChunkFieldSettings();
+};
+
+// AsteroidField - An unbounded asteroid field streamed in cubic chunks
+// around the ship. A chunk's asteroids depend only on the field seed and
+// the chunk coordinate, so leaving a chunk and coming back regenerates the
+// same asteroids (including any that were shot).
+//
+// Every chunk that can be resident at once owns a block of
+// settings.max_asteroids consecutive asteroid rows, allocated with the
+// world, so memory and per-step cost stay fixed however far the ship flies.
+// Chunks are loaded within load_radius of the ship's chunk and unloaded only
+// beyond load_radius + 1, so flying back and forth across a chunk border
+// does not regenerate anything. Missing chunks are loaded nearest first,
+// a bounded number per update, so a restart or a diagonal crossing spreads
+// its generation over several steps.
+class AsteroidField {
+public:
+    ChunkFieldSettings settings;
+
+    AsteroidField();
+
+    // Blocks that can be resident at once, and the asteroid rows they need
+    size_t GetBlockCapacity() const;
+    size_t GetRowCapacity() const;
+
+    // Allocate the block table for settings (with the world)
+    void Create();
+    void Clear();
+    // Unload every chunk and start a new field from seed
+    void Reset(uint64_t seed);
+
+    ChunkCoord GetChunk(const glm::vec3& position) const;
+
+    // Work out the chunks to unload and load for a ship at position, loading
+    // at most max_loads of the chunks still missing. Nothing is unloaded
+    // until the ship enters another chunk. The blocks of unloaded chunks are
+    // returned by GetEvictedBlocks() (their rows must be retired) and the
+    // blocks to fill by GetLoadedBlocks(), in a fixed order.
+    void Update(const glm::vec3& position, int max_loads);
+    const std::vector<int>& GetEvictedBlocks() const { return evicted_blocks; }
+    const std::vector<int>& GetLoadedBlocks() const { return loaded_blocks; }
+
+    // Write the asteroids of the chunk held by block into its rows. Blocks
+    // are disjoint, so different blocks can be generated in parallel.
+    void GenerateBlock(int block, AsteroidComponents& asteroids) const;
+
+    // First asteroid row of block
+    size_t GetFirstRow(int block) const { return static_cast<size_t>(block) * settings.max_asteroids; }
+
+    size_t GetResidentCount() const { return GetBlockCapacity() - free_blocks.size(); }
+    size_t GetChunksGenerated() const { return chunks_generated; }
+
+private:
+    uint64_t seed;
+    std::vector<ChunkCoord> block_chunks;
+    std::vector<uint8_t> block_resident;
+    std::vector<int> free_blocks;
+    std::vector<int> evicted_blocks;
+    std::vector<int> loaded_blocks;
+    ChunkCoord center;
+    bool has_center;
+    size_t chunks_generated;
+
+    // Chunk offsets within load_radius, nearest first; the ones before
+    // next_offset are resident around center
+    std::vector<ChunkCoord> load_offsets;
+    size_t next_offset;
+
+    // Open-addressed table (linear probing) from resident chunk to its
+    // block, -1 in empty entries; sized for at most half full
+    std::vector<int> chunk_table;
+    size_t chunk_table_mask;
+
+    size_t GetTableEntry(const ChunkCoord& chunk) const;
+    int FindBlock(const ChunkCoord& chunk) const;
+    void InsertBlock(int block);
+    void RemoveBlock(int block);
+};
+
+#endif // ASTEROID_FIELD_H
@@ -10,7 +10,10 @@ public:
     glm::vec3 offset_third_person; // Offset for third-person view
 
     Camera();
+    // View matrix of the pose drawn this frame (see GetWorldTransform())
     glm::mat4 GetViewMatrix();
+    // View matrix of the camera's current pose, for use inside a step
+    glm::mat4 ComputeViewMatrix() const;
     void ToggleView();
     void UpdateCameraPosition(SceneNode* ship);
 };
@@ -0,0 +1,31 @@
+#ifndef COLLISION_H
+#define COLLISION_H
+
+#include <glm/glm.hpp>
+
+// Intersection tests shared by the game and the benchmarks (no OpenGL dependency)
+
+// Infinite line through ray_origin along ray_direction vs sphere (discriminant test)
+// Reference: Real-Time Rendering, Chapter on Intersection Tests
+bool RayIntersectsSphere(const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                         const glm::vec3& center, float radius);
+
+// Distance along a normalized ray to the first point inside the sphere
+// (0 when the origin is already inside). Returns false on a miss or when the
+// hit lies beyond max_distance.
+// Reference: Ericson, Real-Time Collision Detection, 5.3.2
+bool RaySphereDistance(const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                       const glm::vec3& center, float radius, float max_distance, float& distance);
+
+// Segment from start to end vs sphere. time_of_impact is the fraction of the
+// segment (0..1) travelled before entering the sphere, 0 when start is inside.
+// Sweeping a projectile from its previous to its new position makes the
+// result independent of the frame time.
+bool SegmentSphereTimeOfImpact(const glm::vec3& start, const glm::vec3& end,
+                               const glm::vec3& center, float radius, float& time_of_impact);
+
+// Sphere-sphere overlap
+bool SpheresOverlap(const glm::vec3& center_a, float radius_a,
+                    const glm::vec3& center_b, float radius_b);
+
+#endif // COLLISION_H
@@ -0,0 +1,29 @@
+#ifndef COLLISION_EVENTS_H
+#define COLLISION_EVENTS_H
+
+#include <glm/glm.hpp>
+#include "slot_map.h"
+
+// Collision detection only records what touched what; score, damage,
+// explosions and HUD feedback are applied afterwards when the events are
+// resolved. Detection therefore never writes to shared game state.
+
+enum class CollisionType {
+    LASER_ASTEROID,
+    MISSILE_ASTEROID,
+    SHIP_ASTEROID
+};
+
+struct CollisionEvent {
+    CollisionType type;
+    EntityHandle asteroid;
+    EntityHandle other;  // The laser, missile or ship
+    glm::vec3 point;  // World-space impact point
+    // Fraction of the projectile's swept segment before contact: 0 at the
+    // beam's tail at its previous position, 1 at its nose at its new one, so
+    // the segment is one beam length longer than the tick's travel. Always 1
+    // for line-test hits and ship contacts, which have no time of impact.
+    float time;
+};
+
+#endif // COLLISION_EVENTS_H
@@ -0,0 +1,42 @@
+#ifndef COLLISION_SIMD_H
+#define COLLISION_SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Batched segment-vs-sphere tests over structure-of-arrays sphere data.
+// The kernels test one segment against 4 (SSE2) or 8 (AVX2) spheres per
+// instruction and give the same results as SegmentSphereTimeOfImpact.
+
+enum class SimdLevel { SCALAR, SSE2, AVX2 };
+
+// Widest kernel supported by both the build and the running CPU
+SimdLevel GetBestSimdLevel();
+bool IsSimdLevelSupported(SimdLevel level);
+const char* GetSimdLevelName(SimdLevel level);
+
+// Sphere centers and radii in separate arrays, so a kernel loads the same
+// component of consecutive spheres with one instruction
+struct SphereArrays {
+    std::vector<float> center_x;
+    std::vector<float> center_y;
+    std::vector<float> center_z;
+    std::vector<float> radius;
+    std::vector<int> user_id;
+
+    void Clear();
+    void Add(const glm::vec3& center, float sphere_radius, int id);
+    size_t GetCount() const { return radius.size(); }
+};
+
+// Test the segment from start to end against every sphere.
+// hit_mask gets one bit per sphere (bit i % 32 of word i / 32) and
+// time_of_impact the fraction of the segment travelled before contact, or
+// infinity for a miss. Returns the number of spheres hit.
+size_t SegmentSphereBatch(SimdLevel level, const SphereArrays& spheres,
+                          const glm::vec3& start, const glm::vec3& end,
+                          std::vector<uint32_t>& hit_mask, std::vector<float>& time_of_impact);
+
+#endif // COLLISION_SIMD_H
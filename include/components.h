@@ -0,0 +1,95 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "slot_map.h"
+
+class SceneNode;
+
+// Components - Plain data for everything the simulation moves. Each kind of
+// entity keeps its components in parallel packed arrays, one row per
+// entity, and the systems in systems.h loop over just the arrays they use.
+// Positions and orientations are separate columns so the broadphase reads
+// only positions and the batch kernels in transform_simd.h run over
+// contiguous quaternions.
+// The scene node is only a render component: the simulation never reads it,
+// and Simulation::SyncNodes() copies poses into it for drawing.
+
+// The ship's pose; asteroids and projectiles keep the same two fields as columns
+struct Transform {
+    glm::vec3 position;
+    glm::quat orientation;
+};
+
+struct Velocity {
+    glm::vec3 linear;
+};
+
+struct Lifetime {
+    float age;
+    float max_age;
+};
+
+// Sphere radius for asteroids; for projectiles, half the beam length
+struct Collider {
+    float radius;
+    int proxy;  // DynamicBvh proxy, -1 when not in the tree
+};
+
+// Ship steering input and handling
+struct ShipMotion {
+    glm::vec3 velocity;
+    glm::vec3 acceleration;
+    float max_speed;
+    float acceleration_rate;
+    float deceleration_rate;
+    bool moving_forward;
+    bool moving_backward;
+    bool moving_left;
+    bool moving_right;
+
+    ShipMotion();
+};
+
+// The asteroid field; live is cleared when an asteroid is destroyed
+struct AsteroidComponents {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> orientations;
+    std::vector<Collider> colliders;
+    std::vector<uint8_t> live;
+    std::vector<EntityHandle> entities;
+    std::vector<SceneNode*> nodes;  // Render component
+
+    size_t GetCount() const { return positions.size(); }
+    void Clear();
+};
+
+// One kind of projectile (lasers or missiles), one row per pool slot. The
+// tuning values are shared by every row and set before CreateWorld().
+struct ProjectileComponents {
+    float speed;
+    float max_lifetime;
+    float spin_rate;    // Radians per second about the flight axis
+    glm::vec3 scale;    // Size of the beam; sets the collider length
+
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> orientations;
+    std::vector<Velocity> velocities;
+    std::vector<Lifetime> lifetimes;
+    std::vector<Collider> colliders;
+    std::vector<uint8_t> active;  // In flight
+    std::vector<EntityHandle> entities;
+    std::vector<SceneNode*> nodes;  // Render component
+
+    ProjectileComponents(float projectile_speed, float projectile_lifetime, float projectile_spin_rate,
+                         glm::vec3 projectile_scale);
+
+    size_t GetCount() const { return positions.size(); }
+    void Clear();
+};
+
+#endif // COMPONENTS_H
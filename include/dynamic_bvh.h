@@ -0,0 +1,82 @@
+#ifndef DYNAMIC_BVH_H
+#define DYNAMIC_BVH_H
+
+#include <cstddef>
+#include <vector>
+#include <glm/glm.hpp>
+
+// Result of a BVH ray or nearest-neighbour query
+struct BvhHit {
+    int user_id;
+    float distance;  // Along the ray, or from the query point to the sphere surface
+};
+
+// DynamicBvh - Incrementally updated bounding volume tree over spheres.
+// Each proxy (one bounding sphere) is a leaf with a fattened AABB. Moving a
+// proxy only touches the tree when the sphere leaves its fat box; then the
+// leaf is removed and reinserted using the surface-area heuristic, and AVL
+// rotations keep the tree balanced. Based on the dynamic tree in Box2D
+// (Erin Catto), extended to 3D.
+class DynamicBvh {
+public:
+    // margin: how far each leaf box is grown beyond its sphere
+    explicit DynamicBvh(float margin = 1.0f);
+
+    // Add a sphere; returns the proxy id used by the other calls
+    int CreateProxy(const glm::vec3& center, float radius, int user_id);
+    void DestroyProxy(int proxy);
+
+    // Update a proxy's sphere. Returns true when the leaf had to be reinserted.
+    bool MoveProxy(int proxy, const glm::vec3& center, float radius);
+
+    void Clear();
+
+    int GetUserId(int proxy) const { return nodes[proxy].user_id; }
+    size_t GetProxyCount() const { return proxy_count; }
+    int GetHeight() const;
+
+    // Closest sphere hit by a normalized ray within max_distance
+    bool RayCast(const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+                 BvhHit& hit) const;
+
+    // Closest sphere hit by the segment from start to end
+    bool SegmentCast(const glm::vec3& start, const glm::vec3& end, BvhHit& hit) const;
+
+    // Append the user ids of all spheres overlapping the query sphere
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<int>& result) const;
+
+    // The k spheres whose surfaces are closest to point, nearest first
+    void QueryNearest(const glm::vec3& point, size_t k, std::vector<BvhHit>& result) const;
+
+private:
+    static const int NULL_NODE = -1;
+
+    struct Node {
+        glm::vec3 box_min;   // Fat AABB (leaves) or union of the children
+        glm::vec3 box_max;
+        glm::vec3 center;    // Leaf sphere
+        float radius;
+        int user_id;
+        int parent;          // Next free node while on the free list
+        int child1;
+        int child2;
+        int height;          // 0 for leaves, -1 for free nodes
+
+        bool IsLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::vector<Node> nodes;
+    int root;
+    int free_list;
+    size_t proxy_count;
+    float margin;
+
+    int AllocateNode();
+    void FreeNode(int index);
+    void InsertLeaf(int leaf);
+    void RemoveLeaf(int leaf);
+    int Balance(int index);
+    void FitToChildren(int index);
+};
+
+#endif // DYNAMIC_BVH_H
@@ -0,0 +1,48 @@
+#ifndef FRAME_UNIFORMS_H
+#define FRAME_UNIFORMS_H
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+// Uniform buffer binding point of the FrameData block in every program
+const GLuint FRAME_UNIFORM_BINDING = 0;
+
+// GLSL declaration of the block. ShaderProgram inserts it after the #version
+// line of every shader stage, so shaders read e.g. frame.view_projection
+// without declaring anything themselves.
+extern const char* FRAME_DATA_GLSL;
+
+// CPU mirror of the FrameData block (std140: mat4/vec4 members are 16-byte aligned,
+// the trailing floats are padded to a full vec4)
+struct FrameData {
+    glm::mat4 view;
+    glm::mat4 projection;
+    glm::mat4 view_projection;
+    glm::mat4 ui_projection;     // Orthographic, window pixels with the origin bottom-left
+    glm::vec4 camera_position;   // xyz = world-space eye position
+    glm::vec4 viewport;          // width, height, 1/width, 1/height
+    float time;
+    float delta_time;
+    float padding[2];
+};
+
+// FrameUniforms - Uniform buffer holding FrameData, uploaded once per frame
+// and bound to FRAME_UNIFORM_BINDING for all shader programs.
+class FrameUniforms {
+public:
+    FrameUniforms();
+    ~FrameUniforms();
+
+    // Create the buffer and attach it to the binding point
+    void Initialize();
+
+    void Update(const FrameData& data);
+
+private:
+    GLuint ubo;
+
+    FrameUniforms(const FrameUniforms&) = delete;
+    FrameUniforms& operator=(const FrameUniforms&) = delete;
+};
+
+#endif // FRAME_UNIFORMS_H
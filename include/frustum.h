@@ -0,0 +1,40 @@
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <glm/glm.hpp>
+
+// World-space bounding sphere. A negative radius marks an empty sphere
+// (e.g. a subtree without any models).
+struct BoundingSphere {
+    glm::vec3 center;
+    float radius;
+
+    BoundingSphere() : center(0.0f), radius(-1.0f) {}
+    BoundingSphere(const glm::vec3& c, float r) : center(c), radius(r) {}
+
+    bool IsEmpty() const { return radius < 0.0f; }
+
+    // Sphere of the given object-space radius around the origin of a world matrix.
+    // The radius is scaled by the largest axis scale so non-uniform scaling stays enclosed.
+    static BoundingSphere FromTransform(const glm::mat4& world, float object_radius);
+
+    // Smallest sphere enclosing both spheres
+    static BoundingSphere Merge(const BoundingSphere& a, const BoundingSphere& b);
+};
+
+// Frustum - six clip planes extracted from a view-projection matrix
+// (Gribb/Hartmann). Planes are normalized and point inwards.
+class Frustum {
+public:
+    Frustum();
+
+    void Extract(const glm::mat4& view_projection);
+
+    // True when the sphere is at least partially inside all six planes
+    bool Intersects(const BoundingSphere& sphere) const;
+
+private:
+    glm::vec4 planes[6];  // left, right, bottom, top, near, far
+};
+
+#endif // FRUSTUM_H
@@ -1,15 +1,23 @@
 #ifndef GEOMETRY_H
 #define GEOMETRY_H
 
+#include <GL/glew.h>
 #include "model.h"
 #include <glm/glm.hpp>
 
 // Helper function for HSV to RGB conversion
 glm::vec3 HSVtoRGB(float h, float s, float v);
 
-// Shape creation functions
-Model* CreateCube(float size, glm::vec3 color);
-Model* CreateSphere(float radius, int latitudes, int longitudes, glm::vec3 color);
-Model* CreateCylinder(float radius, float height, int segments, glm::vec3 color);
+// Pack a vector with components in [-1, 1] into GL_INT_2_10_10_10_REV
+// (signed, normalized; w = 0). Used for normals in the compact vertex formats.
+GLuint PackSnorm1010102(const glm::vec3& v);
+
+// Shape creation functions (color is set per node, not baked into the mesh)
+Model* CreateCube(float size);
+Model* CreateSphere(float radius, int latitudes, int longitudes);
+Model* CreateCylinder(float radius, float height, int segments);
+
+// Free the GPU buffers and the model itself
+void DeleteModel(Model* model);
 
 #endif // GEOMETRY_H
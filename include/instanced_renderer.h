@@ -0,0 +1,55 @@
+#ifndef INSTANCED_RENDERER_H
+#define INSTANCED_RENDERER_H
+
+#include <vector>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "model.h"
+
+class ShaderProgram;
+
+// InstancedRenderer - Batches repeated meshes into instanced draws.
+// Every submitted instance (world matrix + color) is grouped by mesh; Flush()
+// uploads all instances into one streaming buffer and issues a single
+// glDrawElementsInstanced call per mesh, regardless of the instance count.
+class InstancedRenderer {
+public:
+    InstancedRenderer();
+    ~InstancedRenderer();
+
+    // Create the per-instance vertex buffer
+    void Initialize();
+
+    // Start collecting a new frame
+    void Begin();
+
+    void Submit(const Model* model, const glm::mat4& world, const glm::vec3& color);
+
+    // Draw all collected batches with the instanced scene shader
+    void Flush(const ShaderProgram& program);
+
+    // Statistics for the last Flush()
+    unsigned int GetDrawCalls() const { return draw_calls; }
+    unsigned int GetInstanceCount() const { return instance_count; }
+
+private:
+    // Per-instance vertex data, read with a divisor of 1
+    struct InstanceData {
+        glm::mat4 world;
+        glm::vec3 color;
+    };
+
+    struct Batch {
+        const Model* model;
+        std::vector<InstanceData> instances;
+    };
+
+    std::vector<Batch> batches;  // One per mesh, reused every frame
+    GLuint instance_vbo;
+    size_t instance_capacity;    // Instances the buffer can hold
+
+    unsigned int draw_calls;
+    unsigned int instance_count;
+};
+
+#endif // INSTANCED_RENDERER_H
@@ -0,0 +1,124 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem;
+
+// JobGraph - A set of jobs with "runs after" dependencies, built once and
+// executed any number of times with JobSystem::Run(). Jobs without pending
+// prerequisites run in parallel. The first Run() after a change checks the
+// graph for cycles and sizes its run state; later runs reuse it and do not
+// allocate, so a graph is run by one system at a time.
+class JobGraph {
+public:
+    typedef int JobId;
+
+    JobGraph();
+
+    JobId Add(std::function<void()> function);
+    // job starts only after prerequisite has finished
+    void Depend(JobId job, JobId prerequisite);
+    void Clear();
+
+    size_t GetJobCount() const { return nodes.size(); }
+
+private:
+    friend class JobSystem;
+
+    struct Node {
+        std::function<void()> function;
+        std::vector<JobId> successors;
+        int prerequisite_count;
+    };
+    std::vector<Node> nodes;
+
+    // Run state, rebuilt by Prepare() when the graph has changed
+    bool prepared;
+    std::vector<JobId> roots;                     // Nodes without prerequisites
+    std::unique_ptr<std::atomic<int>[]> pending;  // Unfinished prerequisites per node
+
+    void Prepare();
+};
+
+// JobSystem - Work-stealing thread pool. Each thread has its own deque: it
+// pushes and pops work at the back (most recent first, which keeps data
+// warm in its cache) and, when empty, steals the oldest job from the front
+// of another thread's deque. The thread that calls ParallelFor() or Run()
+// takes part in the work until everything it waits for has finished, so
+// a system with one thread runs everything inline.
+//
+// Chunk boundaries depend only on the item count and grain, never on the
+// thread count, so code that writes one result slot per item or per chunk
+// gives the same results with any number of threads.
+class JobSystem {
+public:
+    // thread_count includes the calling thread; 0 uses one per hardware thread
+    explicit JobSystem(unsigned int thread_count = 0);
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int GetThreadCount() const { return thread_count; }
+
+    // Index of the current thread within this job system: 1..GetThreadCount()-1
+    // for its workers and 0 for any other thread, so only one outside thread
+    // (normally the one that created it) should use a system at a time. Use it
+    // to pick per-thread scratch buffers.
+    unsigned int GetThreadIndex() const;
+
+    // Call body(begin, end) for consecutive ranges covering [0, count), each
+    // at most grain items long, and return when all have finished
+    void ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    // Execute every job of the graph, respecting its dependencies
+    void Run(JobGraph& graph);
+
+    // Jobs executed and jobs stolen from another thread since construction
+    size_t GetJobsRun() const { return jobs_run.load(std::memory_order_relaxed); }
+    size_t GetJobsStolen() const { return jobs_stolen.load(std::memory_order_relaxed); }
+
+private:
+    struct Job {
+        void (*function)(void* data, size_t begin, size_t end);
+        void* data;
+        size_t begin;
+        size_t end;
+        std::atomic<size_t>* remaining;  // Decremented when the job has finished
+    };
+
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    unsigned int thread_count;
+    std::vector<std::unique_ptr<WorkQueue>> queues;  // One per thread
+    std::vector<std::thread> workers;
+
+    std::mutex sleep_mutex;
+    std::condition_variable wake;
+    std::atomic<size_t> queued_jobs;
+    bool stopping;
+
+    std::atomic<size_t> jobs_run;
+    std::atomic<size_t> jobs_stolen;
+
+    void WorkerLoop(unsigned int index);
+    void Push(const Job& job);
+    bool TryRunJob(unsigned int index);
+    void WaitFor(std::atomic<size_t>& remaining);
+
+    static void RunGraphNode(void* data, size_t node, size_t unused);
+};
+
+#endif // JOB_SYSTEM_H
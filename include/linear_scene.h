@@ -0,0 +1,98 @@
+#ifndef LINEAR_SCENE_H
+#define LINEAR_SCENE_H
+
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "model.h"
+#include "frustum.h"
+#include "transform_simd.h"
+
+class SceneNode;
+struct RenderContext;
+struct LodChain;
+
+// Flattened SceneNode tree stored in parent-before-child order. Build()
+// gathers the state of every node once and attaches the nodes to their rows;
+// from then on each node pushes its changes into its row (see
+// SceneNode::SetPosition() and its siblings), so the per-frame passes below
+// work on the arrays alone and never follow a node pointer. World matrices
+// stay here and are read back through SceneNode::GetWorldTransform().
+// Building is in linear_scene.cpp, drawing in linear_scene_render.cpp.
+class LinearScene {
+public:
+    LinearScene();
+
+    // Flatten the tree below root and attach its nodes (call again after
+    // nodes are added or removed)
+    void Build(SceneNode* root);
+    bool NeedsRebuild(SceneNode* root) const;
+    // Detach the nodes, handing their interpolation state back, so the tree
+    // can be updated and drawn on its own again. The nodes must still exist.
+    void Clear();
+
+    // Record the pose every row is interpolated from during the next step,
+    // like SceneNode::SaveSimulationState() on the root
+    void SaveSimulationState();
+
+    // Pose each row alpha of the way from its saved to its simulated pose,
+    // rebuild the local matrices that changed with the batch TRS kernel and
+    // propagate world matrices. The simulated pose itself is not touched, so
+    // there is nothing to restore after drawing.
+    void UpdateTransforms(float alpha = 1.0f);
+
+    // Refresh bounding spheres and collect the visible rows to draw. With a
+    // frustum, rows outside it are left out.
+    void BuildDrawList(const Frustum* frustum = nullptr);
+    void Draw(RenderContext& context);
+
+    size_t GetNodeCount() const { return nodes.size(); }
+    size_t GetDrawCount() const { return draw_list.size(); }
+    size_t GetCulledCount() const { return culled_count; }
+
+private:
+    friend class SceneNode;
+
+    SceneNode* root;
+    unsigned int topology_version;
+    SimdLevel simd_level;
+
+    // One entry per node, parents always before their children. nodes is
+    // only used to build, attach and detach.
+    std::vector<SceneNode*> nodes;
+    std::vector<int> parent_indices;        // -1 for the root
+
+    // Node state, kept current by the nodes themselves
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> orientations;
+    std::vector<glm::vec3> scales;
+    std::vector<glm::vec3> previous_positions;
+    std::vector<glm::quat> previous_orientations;
+    std::vector<unsigned char> local_changed;  // Pose or scale set since the last update
+    std::vector<unsigned char> node_visible;   // The node's own flag
+    std::vector<Model*> models;
+    std::vector<float> bounding_radii;
+    std::vector<glm::vec3> colors;
+    std::vector<unsigned char> instanced;
+    std::vector<LodChain*> lods;
+    std::vector<int> lod_levels;
+
+    // Per-frame results
+    std::vector<glm::vec3> draw_positions;   // Interpolated pose the local matrix was built from
+    std::vector<glm::quat> draw_orientations;
+    std::vector<unsigned char> interpolated; // Drawn between two poses last frame
+    std::vector<glm::mat4> local_transforms;
+    std::vector<glm::mat4> world_transforms;
+    std::vector<unsigned char> world_changed;
+    std::vector<unsigned char> visibility;  // node and all ancestors visible
+    std::vector<BoundingSphere> world_bounds;
+    std::vector<BoundingSphere> subtree_bounds;
+    std::vector<unsigned char> inside;      // subtree and all ancestors intersect the frustum
+
+    std::vector<int> draw_list;
+    size_t culled_count;
+
+    void Flatten(SceneNode* node, int parent_index);
+};
+
+#endif // LINEAR_SCENE_H
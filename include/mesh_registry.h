@@ -0,0 +1,99 @@
+#ifndef MESH_REGISTRY_H
+#define MESH_REGISTRY_H
+
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "model.h"
+
+class SceneNode;
+
+// Procedural shape a shared mesh was generated from
+enum class MeshShape {
+    CUBE,
+    SPHERE,
+    CYLINDER
+};
+
+// Generator parameters that uniquely identify a mesh
+struct MeshKey {
+    MeshShape shape;
+    float size_a;   // cube size / sphere radius / cylinder radius
+    float size_b;   // cylinder height
+    int segments_a; // sphere latitudes / cylinder segments
+    int segments_b; // sphere longitudes
+
+    bool operator<(const MeshKey& other) const;
+};
+
+// Fraction by which the screen radius must pass a switch point before the
+// level changes, so meshes near a boundary do not flicker between levels
+const float LOD_HYSTERESIS = 0.15f;
+
+// Screen radius (pixels) below which the finest level gives way to the next;
+// every further level switches at half the previous radius
+const float LOD_FULL_DETAIL_RADIUS = 48.0f;
+
+// LodChain - Tessellation levels of one procedural mesh, finest first.
+// Every level is a registry mesh of its own, so chains with common levels share them.
+struct LodChain {
+    std::vector<Model*> levels;
+    std::vector<float> switch_radius;  // Level i is used down to switch_radius[i] pixels
+
+    // Level to draw at the given projected radius, starting from the current one
+    int Select(float screen_radius, int current) const;
+};
+
+// MeshRegistry - Hands out shared, reference-counted meshes.
+// Identical generator parameters return the same Model; the GPU buffers are
+// deleted when the last reference is released.
+class MeshRegistry {
+public:
+    MeshRegistry();
+    ~MeshRegistry();
+
+    // Each call adds one reference to the returned mesh
+    Model* AcquireCube(float size);
+    Model* AcquireSphere(float radius, int latitudes, int longitudes);
+    Model* AcquireCylinder(float radius, float height, int segments);
+
+    // Chains of progressively coarser tessellations; level 0 uses the given segments
+    LodChain* AcquireSphereLod(float radius, int latitudes, int longitudes);
+    LodChain* AcquireCylinderLod(float radius, float height, int segments);
+
+    // Drop one reference; frees the mesh when none are left
+    void Release(Model* model);
+    void ReleaseLod(LodChain* chain);
+
+    // Release the meshes of a node and all its children and clear their model/LOD pointers
+    void ReleaseTree(SceneNode* node);
+
+    // Number of meshes currently alive on the GPU
+    size_t GetMeshCount() const { return meshes.size(); }
+
+    // Total GPU memory used by vertex and index buffers of all live meshes
+    size_t GetBufferBytes() const;
+
+private:
+    struct Entry {
+        Model* model;
+        int ref_count;
+    };
+    std::map<MeshKey, Entry> meshes;
+    std::map<const Model*, MeshKey> keys;
+
+    struct ChainEntry {
+        LodChain* chain;
+        int ref_count;
+    };
+    std::map<MeshKey, ChainEntry> chains;
+    std::map<const LodChain*, MeshKey> chain_keys;
+
+    Model* Acquire(const MeshKey& key);
+    LodChain* AcquireLod(const MeshKey& key);
+
+    MeshRegistry(const MeshRegistry&) = delete;
+    MeshRegistry& operator=(const MeshRegistry&) = delete;
+};
+
+#endif // MESH_REGISTRY_H
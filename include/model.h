@@ -1,14 +1,24 @@
 #ifndef MODEL_H
 #define MODEL_H
 
-#include <GL/glew.h>
+// Fixed vertex attribute locations shared by every mesh VAO. ShaderProgram
+// binds "vertex", "normal", "color" and "instance_world" to these before linking.
+const unsigned int VERTEX_ATTRIB_LOCATION = 0;
+const unsigned int NORMAL_ATTRIB_LOCATION = 1;
+const unsigned int COLOR_ATTRIB_LOCATION = 2;
+const unsigned int INSTANCE_WORLD_ATTRIB_LOCATION = 3;  // mat4, occupies 3..6
 
-// Store information of one model for rendering
+// Store information of one model for rendering. Handles use unsigned int
+// (GLuint/GLenum) so scene nodes can be compiled without the OpenGL headers.
 typedef struct model {
-    GLuint vbo;         // Vertex buffer object
-    GLuint ebo;         // Element buffer object
-    GLuint size;        // Number of vertices/elements
-    bool use_elements;  // Whether to use element buffer
+    unsigned int vao;         // Vertex array object (attribute layout + buffers)
+    unsigned int vbo;         // Vertex buffer object
+    unsigned int ebo;         // Element buffer object
+    unsigned int size;        // Number of vertices/elements
+    bool use_elements;        // Whether to use element buffer
+    unsigned int index_type;  // GL_UNSIGNED_SHORT when the vertex count fits, else GL_UNSIGNED_INT
+    unsigned int buffer_bytes;  // Vertex + index buffer size on the GPU
+    float bounding_radius;      // Sphere around the model origin enclosing every vertex
 } Model;
 
 #endif // MODEL_H
@@ -4,6 +4,9 @@
 #include <vector>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
+#include "random.h"
+
+class ShaderProgram;
 
 // Explosion instance - tracks position and timing for each explosion
 struct Explosion {
@@ -18,11 +21,12 @@ struct Explosion {
 // Based on Prof. Azami's ParticleDemo with sphere particle rendering
 class ParticleSystem {
 public:
-    ParticleSystem(int num_particles = 5000, int max_explosions = 50);
+    // Particle spray directions come from the PARTICLES stream of run_seed
+    explicit ParticleSystem(uint64_t run_seed, int num_particles = 5000, int max_explosions = 50);
     ~ParticleSystem();
 
     // Initialize OpenGL resources and create particle geometry
-    void Initialize(GLuint particle_shader_program);
+    void Initialize(const ShaderProgram* particle_shader_program);
 
     // Spawn a new explosion at the given position
     void SpawnExplosion(const glm::vec3& position, const glm::vec3& color = glm::vec3(1.0f, 0.6f, 0.0f));
@@ -30,8 +34,11 @@ public:
     // Update explosion states (remove expired ones)
     void Update(float current_time);
 
-    // Render all active explosions
-    void Render(float current_time, const glm::mat4& view_mat, const glm::mat4& projection_mat);
+    // End every explosion at once (restart)
+    void Clear();
+
+    // Render all active explosions (view/projection come from the FrameData block)
+    void Render(float current_time);
 
     // Cleanup OpenGL resources
     void Cleanup();
@@ -40,8 +47,9 @@ private:
     // OpenGL resources
     GLuint vao;                // Vertex Array Object
     GLuint vbo;                // Vertex Buffer Object
-    GLuint shader_program;     // Particle shader program
+    const ShaderProgram* shader_program;  // Particle shader program
     int num_particles;         // Number of particles per explosion
+    Random random;             // Source for particle spray directions
 
     // Explosion tracking
     std::vector<Explosion> explosions;
@@ -0,0 +1,132 @@
+#ifndef PROJECTILE_POOL_H
+#define PROJECTILE_POOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What ProjectilePool::Acquire() does when every slot is in flight
+enum class PoolOverflow {
+    RECYCLE_OLDEST,  // Reuse the projectile fired longest ago
+    REJECT           // Return -1; the shot is not fired
+};
+
+// ProjectilePool - Hands out the rows of a fixed set of projectiles (see
+// ProjectileComponents) created with the world, so firing never allocates
+// or changes the scene graph. Free slots form a stack and slots in flight a
+// linked list in firing order, so Acquire(), Release() and finding the
+// oldest shot are all O(1).
+class ProjectilePool {
+public:
+    PoolOverflow overflow;
+
+    ProjectilePool() : overflow(PoolOverflow::RECYCLE_OLDEST), oldest(-1), newest(-1), active_count(0) {}
+
+    // Start with capacity free slots
+    void Create(size_t capacity) {
+        in_flight.assign(capacity, false);
+        free_slots.reserve(capacity);
+        Reset();
+    }
+
+    void Clear() {
+        free_slots.clear();
+        previous.clear();
+        next.clear();
+        in_flight.clear();
+        oldest = newest = -1;
+        active_count = 0;
+    }
+
+    // Free every slot, in the order Create() leaves them
+    void Reset() {
+        size_t capacity = in_flight.size();
+        previous.assign(capacity, -1);
+        next.assign(capacity, -1);
+        in_flight.assign(capacity, false);
+        free_slots.clear();
+        for (size_t i = capacity; i-- > 0;) {
+            free_slots.push_back(static_cast<int>(i));
+        }
+        oldest = newest = -1;
+        active_count = 0;
+    }
+
+    // A slot to fire: a free one, or per the overflow policy when none is
+    // free; -1 when the shot is rejected
+    int Acquire() {
+        int slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        } else if (overflow == PoolOverflow::RECYCLE_OLDEST && oldest != -1) {
+            slot = oldest;
+            Unlink(slot);
+        } else {
+            return -1;
+        }
+        Link(slot);
+        return slot;
+    }
+
+    // Return slot to the free list (the caller deactivates its projectile)
+    void Release(size_t slot) {
+        if (!in_flight[slot]) return;
+        Unlink(static_cast<int>(slot));
+        free_slots.push_back(static_cast<int>(slot));
+    }
+
+    // Release every slot in flight whose projectile is no longer active
+    // (it reached the end of its lifetime)
+    void ReleaseInactive(const std::vector<uint8_t>& active) {
+        for (int slot = oldest; slot != -1;) {
+            int following = next[slot];
+            if (!active[slot]) {
+                Release(slot);
+            }
+            slot = following;
+        }
+    }
+
+    size_t GetCapacity() const { return in_flight.size(); }
+    size_t GetActiveCount() const { return active_count; }
+
+private:
+    std::vector<int> free_slots;
+    std::vector<int> previous;  // In-flight list, oldest to newest
+    std::vector<int> next;
+    std::vector<bool> in_flight;
+    int oldest;
+    int newest;
+    size_t active_count;
+
+    void Link(int slot) {
+        previous[slot] = newest;
+        next[slot] = -1;
+        if (newest != -1) {
+            next[newest] = slot;
+        } else {
+            oldest = slot;
+        }
+        newest = slot;
+        in_flight[slot] = true;
+        active_count++;
+    }
+
+    void Unlink(int slot) {
+        if (previous[slot] != -1) {
+            next[previous[slot]] = next[slot];
+        } else {
+            oldest = next[slot];
+        }
+        if (next[slot] != -1) {
+            previous[next[slot]] = previous[slot];
+        } else {
+            newest = previous[slot];
+        }
+        in_flight[slot] = false;
+        active_count--;
+    }
+};
+
+#endif // PROJECTILE_POOL_H
@@ -0,0 +1,56 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// Seed used when none is given on the command line, so two runs with the
+// same options produce the same asteroid field, stars and explosions
+const uint64_t DEFAULT_RUN_SEED = 0x5eed;
+
+// Subsystems that draw random numbers. Each gets its own stream derived from
+// the run seed, so extra draws in one subsystem never shift another's numbers.
+enum class RandomStream {
+    ASTEROID_FIELD,
+    STARFIELD,
+    PARTICLES
+};
+
+// Random - xoshiro128** generator (Blackman & Vigna). Small, fast and fully
+// specified, so a seed gives the same sequence on every compiler and platform
+// (unlike rand(), whose algorithm and RAND_MAX are implementation-defined).
+class Random {
+public:
+    explicit Random(uint64_t seed = DEFAULT_RUN_SEED);
+    Random(uint64_t run_seed, RandomStream stream);
+
+    void Seed(uint64_t seed);
+
+    uint32_t NextUInt() {
+        uint32_t result = RotateLeft(state[1] * 5u, 7) * 9u;
+        uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = RotateLeft(state[3], 11);
+        return result;
+    }
+
+    // Uniform in [0, 1)
+    float NextFloat();
+    // Uniform in [min, max)
+    float NextFloat(float min, float max);
+    // Uniform in [min, max], both inclusive
+    int NextInt(int min, int max);
+
+private:
+    uint32_t state[4];
+
+    static uint32_t RotateLeft(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+};
+
+// Parse a seed given as decimal or 0x-prefixed hex; throws std::runtime_error if invalid
+uint64_t ParseSeed(const char* text);
+
+#endif // RANDOM_H
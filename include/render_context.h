@@ -0,0 +1,31 @@
+#ifndef RENDER_CONTEXT_H
+#define RENDER_CONTEXT_H
+
+#include <glm/glm.hpp>
+
+class ShaderProgram;
+class InstancedRenderer;
+class Frustum;
+
+// Per-frame state passed down the scene draw traversal
+struct RenderContext {
+    const ShaderProgram* program;   // Scene shader for individually drawn nodes
+    InstancedRenderer* instancing;  // Collects instanced nodes (null = draw everything individually)
+    const Frustum* frustum;         // Camera frustum for culling (null = no culling)
+
+    // Level of detail: projected radius in pixels = lod_scale * radius / distance
+    glm::vec3 camera_position;
+    float lod_scale;                // 0 = always draw the finest level
+
+    // Statistics for the current frame
+    unsigned int draw_calls;
+    unsigned int nodes_drawn;
+    unsigned int nodes_culled;
+    unsigned int triangles;
+
+    RenderContext()
+        : program(nullptr), instancing(nullptr), frustum(nullptr), camera_position(0.0f),
+          lod_scale(0.0f), draw_calls(0), nodes_drawn(0), nodes_culled(0), triangles(0) {}
+};
+
+#endif // RENDER_CONTEXT_H
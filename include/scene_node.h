@@ -3,31 +3,153 @@
 
 #include <string>
 #include <vector>
-#include <GL/glew.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include "model.h"
+#include "frustum.h"
+
+class LinearScene;
+struct RenderContext;
+struct LodChain;
 
 // SceneNode class - Base class for hierarchical scene graph
 class SceneNode {
 public:
     std::string name;
-    glm::vec3 position;
-    glm::quat orientation;
-    glm::vec3 scale;
     SceneNode* parent;
     std::vector<SceneNode*> children;
-    Model* model;
-    glm::vec3 color;
-    bool visible;
 
     SceneNode(std::string node_name);
     virtual ~SceneNode();
 
     void AddChild(SceneNode* child);
-    glm::mat4 GetWorldTransform();
-    virtual void Draw(GLuint program);
+
+    // Pose and appearance. While the node belongs to a LinearScene every
+    // setter also writes the node's row there, so the scene's per-frame
+    // passes never have to read the node.
+    const glm::vec3& GetPosition() const { return position; }
+    const glm::quat& GetOrientation() const { return orientation; }
+    const glm::vec3& GetScale() const { return scale; }
+    bool IsVisible() const { return visible; }
+    Model* GetModel() const { return model; }
+    const glm::vec3& GetColor() const { return color; }
+    bool IsInstanced() const { return instanced; }
+    LodChain* GetLod() const { return lod; }
+    void SetPosition(const glm::vec3& value);
+    void SetOrientation(const glm::quat& value);
+    void SetScale(const glm::vec3& value);
+    void SetVisible(bool value);
+    void SetModel(Model* value);
+    void SetColor(const glm::vec3& value);
+    // Drawn through the instanced renderer when one is active
+    void SetInstanced(bool value);
+    // Optional tessellation levels; the model is then the finest level
+    void SetLod(LodChain* value);
+
+    // Cached world matrix of the pose drawn this frame. It is refreshed only
+    // by the frame's UpdateTransforms() (or the LinearScene's), so after a
+    // node or an ancestor moves it stays stale until the next frame.
+    const glm::mat4& GetWorldTransform() const;
+    // World matrix of the current pose of this node and its ancestors,
+    // computed on demand for code that runs between frame updates (inside a
+    // step, for example). It walks the parent chain, so prefer
+    // GetWorldTransform() when drawing.
+    glm::mat4 ComputeWorldTransform() const;
+
+    // World-space bounding spheres of this node's model and of its whole subtree
+    // (hidden children left out), valid after UpdateTransforms()
+    const BoundingSphere& GetWorldBounds() const { return world_bounds; }
+    const BoundingSphere& GetSubtreeBounds() const { return subtree_bounds; }
+
+    // Rebuild local/world matrices of nodes whose position, orientation or
+    // scale changed since the last call (and of everything below them), and
+    // refresh the bounding spheres of every subtree that changed.
+    // Call once per frame on the root before drawing. Returns true when
+    // anything in this subtree changed.
+    bool UpdateTransforms(bool parent_changed = false);
+
+    // Force this node's matrices to be rebuilt on the next UpdateTransforms()
+    void MarkDirty();
+
+    // Fixed-timestep rendering. SaveSimulationState() records the pose of the
+    // subtree before a simulation step (or after a teleport, so the node is
+    // not interpolated from where it was). BeginInterpolation() poses the
+    // subtree between that and the current simulated pose for drawing, and
+    // EndInterpolation() restores the simulated pose. A LinearScene poses its
+    // rows itself, so only tree drawing needs the last two.
+    void SaveSimulationState();
+    void BeginInterpolation(float alpha);
+    void EndInterpolation();
+
+    // Drawing lives in scene_node_render.cpp, so nodes can be simulated without OpenGL
+    void Draw(RenderContext& context);
     virtual void Update(float delta_time);
+
+    // Mesh to draw this frame: the model, or the LOD level matching its screen size
+    const Model* SelectModel(const RenderContext& context);
+    // The same for a model drawn with the given world matrix; lod_level is
+    // the level chosen last frame and is updated
+    static const Model* SelectLodModel(const RenderContext& context, const Model* model, const LodChain* lod,
+                                       const glm::mat4& world, int& lod_level);
+
+    // Draw one model, either immediately or by handing it to the instanced renderer
+    static void SubmitModel(RenderContext& context, const Model* model, const glm::mat4& world,
+                            const glm::vec3& color, bool instanced);
+
+    // Issue the draw call for one model with the given world matrix and color
+    static void DrawModel(RenderContext& context, const Model* model,
+                          const glm::mat4& world, const glm::vec3& color);
+
+    // Number of matrices rebuilt since the last reset (debug statistics)
+    static unsigned int GetTransformsRebuilt();
+    static void ResetTransformStats();
+
+    // Incremented whenever a node is attached or destroyed
+    static unsigned int GetTopologyVersion();
+
+private:
+    friend class LinearScene;
+
+    glm::vec3 position;
+    glm::quat orientation;
+    glm::vec3 scale;
+    Model* model;
+    glm::vec3 color;
+    bool visible;
+    bool instanced;
+    LodChain* lod;
+    int lod_level;  // Level chosen last frame (kept for hysteresis)
+
+    // Row of this node in the LinearScene it belongs to, if any
+    LinearScene* scene;
+    int scene_row;
+
+    // Transform cache
+    glm::mat4 local_transform;
+    glm::mat4 world_transform;
+    glm::vec3 cached_position;
+    glm::quat cached_orientation;
+    glm::vec3 cached_scale;
+    bool transform_dirty;
+
+    // Poses for render interpolation
+    glm::vec3 previous_position;
+    glm::quat previous_orientation;
+    glm::vec3 simulated_position;
+    glm::quat simulated_orientation;
+
+    // Bounds cache
+    BoundingSphere world_bounds;
+    BoundingSphere subtree_bounds;
+    unsigned int subtree_model_count;  // Nodes with a model in this subtree, hidden children left out
+    const Model* bounds_model;         // Model the bounds were computed for
+    size_t bounds_child_count;         // Child count the bounds were computed for
+    bool bounds_visible;               // Visibility the parent's bounds saw
+
+    void UpdateBounds();
+
+    static unsigned int transforms_rebuilt;
+    static unsigned int topology_version;
 };
 
 #endif // SCENE_NODE_H
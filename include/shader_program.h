@@ -0,0 +1,88 @@
+#ifndef SHADER_PROGRAM_H
+#define SHADER_PROGRAM_H
+
+#include <string>
+#include <unordered_map>
+#include <GL/glew.h>
+
+// Uniforms used by the game's renderers, resolved once when a program is linked.
+// View/projection matrices are not here: they live in the shared FrameData block.
+enum class UniformSlot {
+    WORLD_MAT,
+    NORMAL_MAT,
+    TIMER,
+    OBJECT_COLOR,
+    COLOR,
+    TEXT_COLOR,
+    COUNT
+};
+
+// Vertex attributes used by the scene shader
+enum class AttribSlot {
+    VERTEX,
+    NORMAL,
+    COLOR,
+    COUNT
+};
+
+// ShaderProgram - Linked GLSL program with a reflection cache.
+// All active uniforms and attributes are enumerated once at link time, so
+// rendering code never has to ask the driver for a location by name.
+class ShaderProgram {
+public:
+    ShaderProgram();
+    ~ShaderProgram();
+
+    // Compile, link and reflect (geometry shader is optional). Every stage gets
+    // the FrameData block (see frame_uniforms.h), bound to FRAME_UNIFORM_BINDING.
+    // Returns false on failure; GetLog() then holds the compiler/linker output.
+    bool Load(const char* vertex_source, const char* fragment_source,
+              const char* geometry_source = nullptr);
+
+    void Use() const;
+    GLuint GetId() const { return id; }
+    const std::string& GetLog() const { return log; }
+
+    // Locations of the well-known uniforms/attributes (-1 if not active)
+    GLint GetUniform(UniformSlot slot) const { return uniform_slots[static_cast<int>(slot)]; }
+    GLint GetAttrib(AttribSlot slot) const { return attrib_slots[static_cast<int>(slot)]; }
+
+    // Ask the driver for a location by name and count the lookup. Code that
+    // includes this header reaches them through glGetUniformLocation and
+    // glGetAttribLocation (see the end of this file).
+    static GLint LookUpUniformLocation(GLuint program, const GLchar* name);
+    static GLint LookUpAttribLocation(GLuint program, const GLchar* name);
+
+    // Driver lookups by name since the last reset (should stay 0 in a
+    // steady-state frame)
+    static unsigned int GetNameLookups();
+    static void ResetNameLookups();
+
+private:
+    GLuint id;
+    std::string log;
+    std::unordered_map<std::string, GLint> uniforms;  // Reflection cache, by name
+    std::unordered_map<std::string, GLint> attributes;
+    GLint uniform_slots[static_cast<int>(UniformSlot::COUNT)];
+    GLint attrib_slots[static_cast<int>(AttribSlot::COUNT)];
+
+    static unsigned int name_lookups;
+
+    GLuint CompileShader(GLenum type, const char* source, const char* label);
+    void Reflect();
+
+    ShaderProgram(const ShaderProgram&) = delete;
+    ShaderProgram& operator=(const ShaderProgram&) = delete;
+};
+
+// Route every by-name location query through the counted lookups, so the
+// F3 overlay sees them wherever they are made. shader_program.cpp turns this
+// off to reach the driver.
+#ifndef SHADER_PROGRAM_RAW_LOOKUPS
+#undef glGetUniformLocation
+#undef glGetAttribLocation
+#define glGetUniformLocation ShaderProgram::LookUpUniformLocation
+#define glGetAttribLocation ShaderProgram::LookUpAttribLocation
+#endif
+
+#endif // SHADER_PROGRAM_H
@@ -0,0 +1,196 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <chrono>
+#include <vector>
+#include "scene_node.h"
+#include "components.h"
+#include "game_state.h"
+#include "random.h"
+#include "spatial_hash.h"
+#include "dynamic_bvh.h"
+#include "collision_simd.h"
+#include "collision_events.h"
+#include "job_system.h"
+#include "projectile_pool.h"
+#include "slot_map.h"
+#include "asteroid_field.h"
+
+// Broadphase for projectile/ship vs asteroid collisions. The grid is rebuilt
+// every tick; the BVH is updated incrementally and answers closest-hit queries.
+// Only the selected one is maintained, so switching to the BVH rebuilds it.
+enum class Broadphase { GRID, BVH, BRUTE_FORCE };
+
+const char* GetBroadphaseName(Broadphase broadphase);
+
+// Asteroid layout built by CreateWorld(): a fixed number on rings around the
+// origin, or an unbounded field streamed in chunks around the ship
+enum class FieldLayout { RINGS, STREAMED };
+
+enum class EntityType { SHIP, ASTEROID, LASER, MISSILE };
+
+// What an entity handle refers to
+struct Entity {
+    EntityType type;
+    int index;  // Row in the component arrays of its kind
+};
+
+// Simulation - The game world without any rendering: ship, asteroids,
+// projectiles, the cannon animation and collision handling. It depends on
+// neither GLFW nor OpenGL, so the window build and the headless build share
+// it.
+//
+// Entity state lives in packed component arrays (components.h) and is
+// advanced by the systems in systems.h; nothing in a step reads a scene
+// node. Each entity also has a render node under root, which the game
+// fills with meshes and visual children after CreateWorld() and updates
+// with SyncNodes() after each step.
+//
+// A step runs as a job graph: the ship update, field streaming and broadphase
+// refresh run in turn beside the cannon animation; chunk generation,
+// projectile integration and collision queries are spread over the job
+// system's threads, and results are gathered in a fixed order, so a step
+// gives the same outcome with any number of threads.
+class Simulation {
+public:
+    SceneNode* root;
+    SceneNode* ship;  // Render node of the ship
+    SceneNode* cannon_root;
+    GameManager* game;  // Not owned
+    JobSystem* jobs;    // Not owned
+
+    // Entity components
+    Transform ship_transform;
+    ShipMotion ship_motion;
+    AsteroidComponents asteroids;
+    ProjectileComponents lasers;
+    ProjectileComponents missiles;
+    ProjectilePool laser_pool;
+    ProjectilePool missile_pool;
+
+    // Every ship, asteroid and projectile of the world. Collision events
+    // and other code outside a step name entities by handle; handles go
+    // stale when the world is destroyed or reset, when the chunk holding an
+    // asteroid is unloaded, or when a projectile's pool slot is fired again,
+    // so they are never dereferenced into a world (or a recycled row) that
+    // no longer holds their entity.
+    SlotMap<Entity> entities;
+
+    // Pool sizes used by CreateWorld(); the overflow policy is set on each pool
+    size_t laser_capacity;
+    size_t missile_capacity;
+
+    // Asteroid layout used by CreateWorld(); field.settings tunes a streamed field
+    FieldLayout field_layout;
+    AsteroidField field;
+
+    // Collision settings
+    Broadphase broadphase;
+    bool use_swept_collision;  // Off: infinite-line test at the new position
+    SimdLevel simd_level;      // Kernels for brute force swept tests and the asteroid spin
+
+    // Collisions applied by the last Step(), in detection order
+    std::vector<CollisionEvent> events;
+
+    // Statistics for the last Step()
+    unsigned int collision_tests;  // Narrowphase tests (BVH: tree queries)
+    float detect_microseconds;
+    float resolve_microseconds;
+
+    // Last time chunks were loaded into a streamed field: how many, and how
+    // long generating them took (kept until the next load)
+    size_t field_chunks_loaded;
+    float field_generate_microseconds;
+
+    // Asteroid placement (or a streamed field's seed) draws from the
+    // ASTEROID_FIELD stream of run_seed; each CreateWorld() or ResetWorld()
+    // continues the stream, so every restart gets a new but reproducible field
+    Simulation(GameManager* game_manager, JobSystem* job_system, uint64_t run_seed);
+    ~Simulation();
+
+    // Build the ship, asteroid field, cannon and projectile pools under a new
+    // root node. asteroid_count sets the ring layout's size; a streamed field
+    // gets one row per asteroid its resident chunks can hold.
+    void CreateWorld(int asteroid_count);
+    // Delete every node (including any the caller attached) and reset the collision structures
+    void DestroyWorld();
+    // Return the world built by CreateWorld() to its starting state without
+    // allocating: the ship back at the origin, a new field laid out on the
+    // same asteroid rows and empty projectile pools. A streamed field starts
+    // with only the ship's chunk and fills in over the next steps. Render
+    // nodes keep their meshes and children and are updated by the next
+    // SyncNodes().
+    void ResetWorld();
+
+    // Copy the pose and visibility of every entity into its render node.
+    // The game calls it after each step; headless runs never need it.
+    void SyncNodes();
+
+    // Position of the entity a handle refers to, or nullptr when it is stale
+    const glm::vec3* GetPosition(EntityHandle handle) const;
+
+    // Fire a pooled projectile from the ship's nose. Returns a new handle for
+    // the shot, or a null handle when the pool is full and its overflow
+    // policy is REJECT.
+    EntityHandle FireLaser();
+    EntityHandle FireMissile();
+
+    // Advance the world by one fixed step (does nothing unless playing)
+    void Step(float delta_time);
+
+private:
+    // Buffers for one thread's collision queries
+    struct CollisionScratch {
+        std::vector<int> candidates;
+        std::vector<uint32_t> hit_mask;
+        std::vector<float> impact_times;
+    };
+
+    EntityHandle ship_entity;
+    Random field_random;
+    SpatialHash asteroid_grid;
+    DynamicBvh asteroid_tree;
+    SphereArrays asteroid_spheres;
+    std::vector<CollisionScratch> scratch;  // One per job system thread
+
+    // Detection results, one slot per laser then per missile (asteroid -1
+    // when it hit nothing), plus the ship's contacts. Each job writes only its
+    // own slots; ResolveCollisions() reads them in order.
+    std::vector<CollisionEvent> projectile_hits;
+    std::vector<unsigned int> projectile_tests;
+    std::vector<CollisionEvent> ship_hits;
+    unsigned int ship_tests;
+
+    // Step job graph, built once in the constructor
+    JobGraph step_graph;
+    float step_delta_time;
+    std::chrono::steady_clock::time_point detect_start;
+
+    void BuildStepGraph();
+    void PlaceAsteroids();
+    uint64_t NextFieldSeed();
+    void StreamAsteroidField(int max_loads);
+    void RegisterEntities();
+    void CreateProjectiles(ProjectileComponents& projectiles, ProjectilePool& pool, size_t capacity,
+                           const char* name);
+    EntityHandle LaunchProjectile(ProjectileComponents& projectiles, ProjectilePool& pool);
+    void ReleaseProjectile(ProjectileComponents& projectiles, ProjectilePool& pool, size_t slot);
+    void UpdateBroadphase();
+    void RebuildAsteroidGrid();
+    void RebuildAsteroidSpheres();
+    void ClearAsteroidTree();
+    void UpdateAsteroidTree();
+    void FindAsteroidCandidates(const glm::vec3& start, const glm::vec3& end, float radius,
+                                std::vector<int>& candidates) const;
+    int FindProjectileHit(const glm::vec3& previous_position, const glm::vec3& position,
+                          const glm::vec3& direction, float half_length, CollisionScratch& buffers,
+                          unsigned int& tests, float& time_of_impact) const;
+    void DetectProjectileCollision(ProjectileComponents& projectiles, size_t row, size_t slot, CollisionType type);
+    void DetectProjectileCollisions();
+    void DetectShipCollisions();
+    void ResolveCollisions();
+    void DestroyAsteroid(size_t index);
+    void RotateAsteroids();
+};
+
+#endif // SIMULATION_H
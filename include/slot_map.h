@@ -0,0 +1,132 @@
+#ifndef SLOT_MAP_H
+#define SLOT_MAP_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// EntityHandle - Names an entry of a SlotMap. A slot's generation changes
+// whenever its entry is removed, so a handle kept past that point is seen
+// as stale instead of reaching whatever occupies the slot next. The default
+// handle (generation 0) never refers to anything.
+struct EntityHandle {
+    uint32_t index;
+    uint32_t generation;
+
+    EntityHandle() : index(0), generation(0) {}
+    EntityHandle(uint32_t slot_index, uint32_t slot_generation) : index(slot_index), generation(slot_generation) {}
+
+    bool IsNull() const { return generation == 0; }
+    bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+};
+
+// SlotMap - Values kept packed in one array and addressed through
+// generational handles. Insert(), Remove() and Get() are O(1); removing
+// moves the last value into the hole, so the values stay contiguous and
+// bulk iteration never skips dead entries.
+template <typename T>
+class SlotMap {
+public:
+    EntityHandle Insert(const T& value) {
+        uint32_t slot;
+        if (!free_slots.empty()) {
+            slot = free_slots.back();
+            free_slots.pop_back();
+        } else {
+            slot = static_cast<uint32_t>(slots.size());
+            Slot new_slot;
+            new_slot.dense_index = FREE;
+            new_slot.generation = 1;
+            slots.push_back(new_slot);
+            // Room for every slot to be free, so Remove() and Clear() never allocate
+            if (free_slots.capacity() < slots.capacity()) {
+                free_slots.reserve(slots.capacity());
+            }
+        }
+        slots[slot].dense_index = static_cast<uint32_t>(values.size());
+        values.push_back(value);
+        value_slots.push_back(slot);
+        return EntityHandle(slot, slots[slot].generation);
+    }
+
+    // Returns false if the handle was already stale
+    bool Remove(EntityHandle handle) {
+        if (!Contains(handle)) return false;
+        Slot& slot = slots[handle.index];
+        uint32_t last = static_cast<uint32_t>(values.size() - 1);
+        if (slot.dense_index != last) {
+            values[slot.dense_index] = values[last];
+            value_slots[slot.dense_index] = value_slots[last];
+            slots[value_slots[last]].dense_index = slot.dense_index;
+        }
+        values.pop_back();
+        value_slots.pop_back();
+        Retire(handle.index);
+        free_slots.push_back(handle.index);
+        return true;
+    }
+
+    // Remove every value; all handles issued so far become stale. Storage is
+    // kept, and slots are handed out again from index 0.
+    void Clear() {
+        for (uint32_t slot : value_slots) {
+            Retire(slot);
+        }
+        values.clear();
+        value_slots.clear();
+        free_slots.clear();
+        for (size_t i = slots.size(); i-- > 0;) {
+            free_slots.push_back(static_cast<uint32_t>(i));
+        }
+    }
+
+    bool Contains(EntityHandle handle) const {
+        return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+               slots[handle.index].dense_index != FREE;
+    }
+
+    // The value of a live handle, nullptr for a stale one
+    T* Get(EntityHandle handle) {
+        return Contains(handle) ? &values[slots[handle.index].dense_index] : nullptr;
+    }
+    const T* Get(EntityHandle handle) const {
+        return Contains(handle) ? &values[slots[handle.index].dense_index] : nullptr;
+    }
+
+    // Packed access for bulk iteration; the order changes when values are removed
+    size_t GetSize() const { return values.size(); }
+    T& operator[](size_t dense_index) { return values[dense_index]; }
+    const T& operator[](size_t dense_index) const { return values[dense_index]; }
+    EntityHandle GetHandle(size_t dense_index) const {
+        uint32_t slot = value_slots[dense_index];
+        return EntityHandle(slot, slots[slot].generation);
+    }
+    typename std::vector<T>::iterator begin() { return values.begin(); }
+    typename std::vector<T>::iterator end() { return values.end(); }
+    typename std::vector<T>::const_iterator begin() const { return values.begin(); }
+    typename std::vector<T>::const_iterator end() const { return values.end(); }
+
+private:
+    static constexpr uint32_t FREE = 0xffffffffu;
+
+    struct Slot {
+        uint32_t dense_index;  // FREE when the slot holds nothing
+        uint32_t generation;   // Of the live handle, or of the next one issued
+    };
+
+    std::vector<T> values;
+    std::vector<uint32_t> value_slots;  // Slot of each value
+    std::vector<Slot> slots;
+    std::vector<uint32_t> free_slots;   // Reused last in, first out
+
+    void Retire(uint32_t slot) {
+        slots[slot].dense_index = FREE;
+        // Skip 0 on wrap-around so a retired slot never matches the null handle
+        if (++slots[slot].generation == 0) {
+            slots[slot].generation = 1;
+        }
+    }
+};
+
+#endif // SLOT_MAP_H
@@ -0,0 +1,56 @@
+#ifndef SPATIAL_HASH_H
+#define SPATIAL_HASH_H
+
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+// SpatialHash - Uniform-grid broadphase for bounding spheres.
+// Objects are inserted into every grid cell their bounds overlap; cells are
+// hashed into a fixed bucket table that is rebuilt with a counting sort, so a
+// full rebuild is O(objects) and allocation-free once the buffers have grown.
+// Queries return candidate ids (possibly including false positives from
+// neighbouring cells or hash collisions) for an exact narrowphase test.
+//
+// Usage per tick: Clear(), Insert() every object, Build(), then query.
+class SpatialHash {
+public:
+    explicit SpatialHash(float cell_size = 8.0f);
+
+    void SetCellSize(float size);
+    float GetCellSize() const { return cell_size; }
+
+    void Clear();
+    void Insert(int id, const glm::vec3& center, float radius);
+    void Build();
+
+    // Append the ids of objects near the query to result (each id once)
+    void QuerySphere(const glm::vec3& center, float radius, std::vector<int>& result) const;
+    void QuerySegment(const glm::vec3& start, const glm::vec3& end, float radius,
+                      std::vector<int>& result) const;
+
+    size_t GetObjectCount() const { return object_count; }
+    size_t GetEntryCount() const { return sorted_ids.size(); }
+
+private:
+    struct Entry {
+        uint32_t hash;  // Cell hash, reduced to a bucket in Build()
+        int id;
+    };
+
+    float cell_size;
+    float inv_cell_size;
+    size_t object_count;
+
+    std::vector<Entry> entries;           // One per (object, cell) pair
+    std::vector<int> sorted_ids;          // Entry ids grouped by bucket
+    std::vector<uint32_t> bucket_start;   // Bucket b spans [bucket_start[b], bucket_start[b + 1])
+    std::vector<uint32_t> bucket_cursor;  // Scratch for the counting sort
+    uint32_t bucket_mask;
+
+    glm::ivec3 CellOf(const glm::vec3& point) const;
+    static uint32_t HashCell(int x, int y, int z);
+    void QueryBox(const glm::vec3& min, const glm::vec3& max, std::vector<int>& result) const;
+};
+
+#endif // SPATIAL_HASH_H
@@ -1,6 +1,7 @@
 #ifndef STARFIELD_H
 #define STARFIELD_H
 
+#include <cstdint>
 #include <vector>
 #include <GL/glew.h>
 #include <glm/glm.hpp>
@@ -15,7 +16,8 @@ struct Star {
 // Starfield background with procedural stars
 class Starfield {
 public:
-    Starfield(int num_stars = 1000);
+    // Star positions come from the STARFIELD stream of run_seed
+    explicit Starfield(uint64_t run_seed, int num_stars = 1000);
     ~Starfield();
 
     void Render(GLuint shader_program);
@@ -26,7 +28,7 @@ private:
     GLuint vao;
     int star_count;
 
-    void GenerateStars(int num_stars);
+    void GenerateStars(uint64_t run_seed, int num_stars);
     void InitializeBuffers();
 };
 
@@ -0,0 +1,33 @@
+#ifndef SYSTEMS_H
+#define SYSTEMS_H
+
+#include <cstddef>
+#include "components.h"
+#include "transform_simd.h"
+
+// Systems - The per-tick behavior of ships, asteroids and projectiles, as
+// loops over packed components. Range arguments let the job system split
+// the work; each row is written only by the call that covers it.
+
+// Accelerate the ship towards the velocity its input asks for and move it
+void UpdateShip(ShipMotion& motion, Transform& transform, float delta_time);
+
+// Launch the projectile in row from position along orientation
+void FireProjectile(ProjectileComponents& projectiles, size_t row, const glm::vec3& position,
+                    const glm::quat& orientation);
+
+// Age an active projectile and move it; returns false once its lifetime has
+// run out, leaving it inactive
+bool AdvanceProjectile(ProjectileComponents& projectiles, size_t row, float delta_time);
+
+// Turn the asteroids in [begin, end) by rotation (in their own frame). Dead
+// rows are turned too: the batch kernel is cheaper than skipping them, and
+// they are never drawn or read.
+void SpinAsteroids(AsteroidComponents& asteroids, const glm::quat& rotation, SimdLevel level, size_t begin,
+                   size_t end);
+
+// Copy pose and visibility into the render nodes of rows [begin, end)
+void SyncAsteroidNodes(const AsteroidComponents& asteroids, size_t begin, size_t end);
+void SyncProjectileNodes(const ProjectileComponents& projectiles);
+
+#endif // SYSTEMS_H
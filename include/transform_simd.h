@@ -0,0 +1,39 @@
+#ifndef TRANSFORM_SIMD_H
+#define TRANSFORM_SIMD_H
+
+#include <cstddef>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include "collision_simd.h"
+
+// Batched quaternion and matrix math for the per-tick and per-frame transform
+// loops. The SSE2 kernels work on 4 objects per instruction (AVX2 uses the
+// SSE2 kernels too) and agree with the scalar helpers to within rounding.
+
+// (0, 0, -1) rotated by orientation, without building a rotation matrix
+glm::vec3 QuatForward(const glm::quat& orientation);
+
+// translate(position) * mat4_cast(orientation) * scale(scale), written out
+// directly instead of as two matrix products
+glm::mat4 ComposeTrs(const glm::vec3& position, const glm::quat& orientation, const glm::vec3& scale);
+
+// Normal matrix of an affine world matrix: the inverse-transpose of its upper
+// 3x3 from cofactors instead of a full 4x4 inverse. The translation is left
+// out; it does not apply to normals.
+glm::mat4 AffineNormalMatrix(const glm::mat4& world);
+
+// out[i] = quats[i] * rotation; out may be quats
+void MultiplyQuatsBatch(SimdLevel level, const glm::quat* quats, const glm::quat& rotation, glm::quat* out,
+                        size_t count);
+
+// forward[i] = QuatForward(quats[i])
+void QuatForwardBatch(SimdLevel level, const glm::quat* quats, glm::vec3* forward, size_t count);
+
+// out[i] = ComposeTrs(positions[i], orientations[i], scales[i])
+void ComposeTrsBatch(SimdLevel level, const glm::vec3* positions, const glm::quat* orientations,
+                     const glm::vec3* scales, glm::mat4* out, size_t count);
+
+// normal[i] = AffineNormalMatrix(world[i]); normal may be world
+void AffineNormalMatrixBatch(SimdLevel level, const glm::mat4* world, glm::mat4* normal, size_t count);
+
+#endif // TRANSFORM_SIMD_H
@@ -8,6 +8,7 @@
 #include <memory>
 
 class TextRenderer;
+class ShaderProgram;
 
 /**
  * Button - Interactive UI element for menus
@@ -22,7 +23,7 @@ public:
     void Update(double mouse_x, double mouse_y);
 
     // Render the button
-    void Render(TextRenderer* text_renderer, GLuint shader_program);
+    void Render(TextRenderer* text_renderer, const ShaderProgram* shader_program);
 
     // Check if button was clicked
     bool IsClicked(double mouse_x, double mouse_y);
@@ -60,7 +61,7 @@ private:
     // Quad rendering for button background
     GLuint VAO_, VBO_;
     void InitializeQuad();
-    void RenderQuad(GLuint shader_program, const glm::vec3& color);
+    void RenderQuad(const ShaderProgram* shader_program, const glm::vec3& color);
 };
 
 #endif // BUTTON_H
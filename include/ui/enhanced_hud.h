@@ -9,6 +9,7 @@
 #include <vector>
 
 class TextRenderer;
+class ShaderProgram;
 
 /**
  * EnhancedHUD - Modern OpenGL-based HUD system
@@ -44,6 +45,11 @@ public:
     // Trigger damage flash effect
     void TriggerDamageFlash() { damage_flash_timer_ = 0.5f; }
 
+    // Debug statistics overlay (toggled with F3)
+    void SetDebugLines(const std::vector<std::string>& lines) { debug_lines_ = lines; }
+    void ToggleDebugInfo() { show_debug_info_ = !show_debug_info_; }
+    bool IsDebugInfoVisible() const { return show_debug_info_; }
+
 private:
     int window_width_, window_height_;
     TextRenderer* text_renderer_;
@@ -71,6 +77,10 @@ private:
     };
     std::vector<ScorePopup> score_popups_;
 
+    // Debug overlay
+    bool show_debug_info_;
+    std::vector<std::string> debug_lines_;
+
     // Rendering functions
     void RenderHealthBar();
     void RenderScore();
@@ -81,11 +91,13 @@ private:
     void RenderCrosshair();
     void RenderScorePopups();
     void RenderDamageFlash();
+    void RenderDebugInfo();
 
     // Bar rendering
     GLuint bar_VAO_, bar_VBO_;
-    GLuint bar_shader_program_;
-    void InitializeBarRendering();
+    std::unique_ptr<ShaderProgram> bar_shader_program_;
+    GLint bar_color_loc_;
+    bool InitializeBarRendering();
     void RenderBar(float x, float y, float width, float height,
                    float fill_percentage, const glm::vec3& color);
 };
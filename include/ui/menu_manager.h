@@ -11,6 +11,7 @@
 
 class Button;
 class TextRenderer;
+class ShaderProgram;
 
 enum class MenuState {
     MAIN_MENU,
@@ -65,8 +66,8 @@ private:
 
     // UI Components
     std::unique_ptr<TextRenderer> text_renderer_;
-    GLuint text_shader_program_;
-    GLuint ui_shader_program_;
+    std::unique_ptr<ShaderProgram> text_shader_program_;
+    std::unique_ptr<ShaderProgram> ui_shader_program_;
 
     // Buttons for different menus
     std::vector<std::shared_ptr<Button>> main_menu_buttons_;
@@ -95,9 +96,6 @@ private:
     void RenderGameOverScreen();
     void RenderInstructions();
     void RenderSettings();
-
-    GLuint LoadShaders(const char* vertex_shader, const char* fragment_shader);
-    GLuint CompileShader(const char* source, GLenum shader_type);
 };
 
 #endif // MENU_MANAGER_H
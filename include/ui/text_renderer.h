@@ -6,6 +6,8 @@
 #include <map>
 #include <string>
 
+class ShaderProgram;
+
 // Character holding all state information relevant to a single character
 struct Character {
     GLuint textureID;   // ID handle of the glyph texture
@@ -25,22 +27,19 @@ public:
     ~TextRenderer();
 
     // Initialize the text renderer with shader program
-    bool Initialize(GLuint shader_program);
+    bool Initialize(const ShaderProgram* shader_program);
 
     // Render text at specified position with color and scale
     void RenderText(const std::string& text, float x, float y, float scale,
                     const glm::vec3& color);
 
-    // Set the projection matrix for text rendering (orthographic)
-    void SetProjection(const glm::mat4& projection);
-
     // Load a bitmap font (simplified version without FreeType)
     bool LoadBitmapFont();
 
 private:
     GLuint VAO, VBO;
-    GLuint shader_program_;
-    glm::mat4 projection_;
+    const ShaderProgram* shader_program_;
+    GLint text_color_loc_;
     std::map<char, Character> characters_;
 
     // Create a simple bitmap font atlas
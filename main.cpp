@@ -16,7 +16,21 @@
  *   C           - Toggle camera view
  *   P           - Pause/Resume
  *   R           - Restart (when game over)
+ *   F3          - Toggle debug statistics
+ *   F4          - Toggle flattened scene traversal
+ *   F5          - Toggle instanced rendering
+ *   F6          - Toggle frustum culling
+ *   F7          - Toggle level of detail
+ *   F8          - Cycle collision broadphase (grid / BVH / brute force)
+ *   F9          - Toggle swept (continuous) projectile collision
  *   Q           - Quit
+ *
+ * Command line:
+ *   --asteroids N  - Lay N asteroids out on rings instead of streaming an endless field
+ *   --benchmark    - Start playing immediately and print frame statistics
+ *   --tick-rate N  - Simulation steps per second (default 60)
+ *   --seed N       - Run seed for the asteroid field, stars and explosions
+ *   --threads N    - Threads for simulation jobs (default: one per hardware thread)
  */
 
 #include <iostream>
@@ -24,6 +38,7 @@
 #include <string>
 #include <vector>
 #include <cmath>
+#include <cstdlib>
 #include <algorithm>
 #include <fstream>
 #include <sstream>
@@ -44,16 +59,22 @@
 // Include our custom headers
 #include "model.h"
 #include "scene_node.h"
-#include "ship.h"
 #include "camera.h"
-#include "laser.h"
-#include "missile.h"
-#include "asteroid.h"
 #include "geometry.h"
 #include "game_state.h"
 #include "hud.h"
 #include "starfield.h"
 #include "particle_system.h"
+#include "linear_scene.h"
+#include "shader_program.h"
+#include "mesh_registry.h"
+#include "render_context.h"
+#include "instanced_renderer.h"
+#include "frustum.h"
+#include "frame_uniforms.h"
+#include "simulation.h"
+#include "random.h"
+#include "job_system.h"
 
 // UI System
 #include "ui/text_renderer.h"
@@ -73,15 +94,13 @@ float camera_far_clip_distance_g = 1000.0f;
 float camera_fov_g = 60.0f;
 
 // Shaders
-const char *source_vp = "#version 130\n\
+const char *source_vp = "#version 330\n\
 \n\
 in vec3 vertex;\n\
 in vec3 normal;\n\
 in vec3 color;\n\
 \n\
 uniform mat4 world_mat;\n\
-uniform mat4 view_mat;\n\
-uniform mat4 projection_mat;\n\
 uniform mat4 normal_mat;\n\
 \n\
 out vec4 color_interp;\n\
@@ -91,14 +110,40 @@ out vec3 position_interp;\n\
 void main()\n\
 {\n\
     vec4 position = world_mat * vec4(vertex, 1.0);\n\
-    gl_Position = projection_mat * view_mat * position;\n\
+    gl_Position = frame.view_projection * position;\n\
     \n\
     position_interp = position.xyz;\n\
     normal_interp = (normal_mat * vec4(normal, 0.0)).xyz;\n\
     color_interp = vec4(color, 1.0);\n\
 }";
 
-const char *source_fp = "#version 130\n\
+// Instanced variant of source_vp: the world matrix and color come from
+// per-instance attributes instead of uniforms
+const char *source_instanced_vp = "#version 330\n\
+\n\
+in vec3 vertex;\n\
+in vec3 normal;\n\
+in vec3 color;\n\
+in mat4 instance_world;\n\
+\n\
+out vec4 color_interp;\n\
+out vec3 normal_interp;\n\
+out vec3 position_interp;\n\
+\n\
+void main()\n\
+{\n\
+    vec4 position = instance_world * vec4(vertex, 1.0);\n\
+    gl_Position = frame.view_projection * position;\n\
+    \n\
+    // Inverse-transpose of a rotation * scale matrix without an inverse()\n\
+    mat3 m = mat3(instance_world);\n\
+    vec3 scale_sq = vec3(dot(m[0], m[0]), dot(m[1], m[1]), dot(m[2], m[2]));\n\
+    position_interp = position.xyz;\n\
+    normal_interp = m * (normal / scale_sq);\n\
+    color_interp = vec4(color, 1.0);\n\
+}";
+
+const char *source_fp = "#version 330\n\
 \n\
 in vec4 color_interp;\n\
 in vec3 normal_interp;\n\
@@ -119,19 +164,59 @@ void main()\n\
     FragColor = vec4(lighting, color_interp.a);\n\
 }";
 
-// Global game objects
-Ship* g_ship = nullptr;
+// Global game objects. The ship, asteroids, projectiles and collision
+// handling live in g_simulation, which the headless build shares.
+Simulation* g_simulation = nullptr;
+JobSystem* g_job_system = nullptr;
 Camera* g_camera = nullptr;
-SceneNode* g_root = nullptr;
-SceneNode* g_cannon_root = nullptr;
-std::vector<Laser*> g_lasers;
-std::vector<Missile*> g_missiles;
-std::vector<Asteroid*> g_asteroids;
-GLuint g_program = 0;
-GLuint g_particle_program = 0;  // Particle shader program
+ShaderProgram* g_program = nullptr;
+ShaderProgram* g_particle_program = nullptr;  // Particle shader program
+ShaderProgram* g_instanced_program = nullptr; // Scene shader for instanced batches
 glm::mat4 g_projection_matrix;
+int g_viewport_width = window_width_g;
+int g_viewport_height = window_height_g;
+
+// Per-frame camera/viewport data shared by every shader program
+FrameUniforms* g_frame_uniforms = nullptr;
 double g_last_time = 0.0;
 
+// Fixed-timestep simulation: frame time is accumulated and UpdateGame runs in
+// steps of exactly g_fixed_step; rendering interpolates between the last two
+// simulated poses
+const float MAX_FRAME_TIME = 0.25f;     // Longer frames (debugger, window drag) are clamped
+const int MAX_STEPS_PER_FRAME = 8;      // Backlog beyond this is dropped, avoiding a spiral of death
+int g_tick_rate = 60;
+float g_fixed_step = 1.0f / 60.0f;
+float g_accumulator = 0.0f;
+int g_frame_steps = 0;                  // Simulation steps run for the current frame
+
+// Shared meshes used by scene nodes
+MeshRegistry* g_mesh_registry = nullptr;
+
+// Flattened copy of the scene graph used for linear update/draw traversal
+LinearScene g_linear_scene;
+bool g_use_linear_scene = false;
+
+// Batches asteroids, lasers and missiles into one draw call per mesh
+InstancedRenderer* g_instanced_renderer = nullptr;
+bool g_use_instancing = true;
+
+// Skip nodes whose bounding sphere lies outside the camera frustum
+bool g_use_culling = true;
+
+// Pick coarser sphere/cylinder tessellations for meshes that are small on screen
+bool g_use_lod = true;
+
+// Shader name lookups issued during the previous frame (debug statistics)
+unsigned int g_frame_name_lookups = 0;
+
+// Command line options
+FieldLayout g_field_layout = FieldLayout::STREAMED;
+int g_asteroid_count = 15;  // Ring layout only
+bool g_benchmark = false;
+uint64_t g_run_seed = DEFAULT_RUN_SEED;  // Every random stream derives from this
+unsigned int g_thread_count = 0;         // 0: one per hardware thread
+
 // New game systems
 GameManager* g_game_manager = nullptr;
 HUD* g_hud = nullptr;
@@ -146,8 +231,10 @@ EnhancedHUD* g_enhanced_hud = nullptr;
 double g_mouse_x = 0.0;
 double g_mouse_y = 0.0;
 
-// Forward declaration
+// Forward declarations
 void InitializeScene();
+void DestroyScene();
+void RestartGame();
 
 // Helper function to load shader source from file
 std::string LoadShaderFile(const std::string& filepath) {
@@ -193,10 +280,7 @@ void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
 
     // Game over state - restart
     if (g_game_manager->current_state == GameState::GAME_OVER && key == GLFW_KEY_R && action == GLFW_PRESS) {
-        g_asteroids.clear();
-        delete g_root;
-        InitializeScene();
-        g_game_manager->StartGame();
+        RestartGame();
         return;
     }
 
@@ -239,250 +323,320 @@ void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods
         g_camera->ToggleView();
     }
 
+    if (key == GLFW_KEY_F3 && action == GLFW_PRESS && g_enhanced_hud) {
+        g_enhanced_hud->ToggleDebugInfo();
+    }
+
+    if (key == GLFW_KEY_F4 && action == GLFW_PRESS) {
+        g_use_linear_scene = !g_use_linear_scene;
+        if (g_use_linear_scene) {
+            g_linear_scene.Build(g_simulation->root);
+        } else {
+            // Nodes take their state back and the tree rebuilds its matrices and bounds
+            g_linear_scene.Clear();
+            g_simulation->root->MarkDirty();
+        }
+        std::cout << "Scene traversal: " << (g_use_linear_scene ? "LINEAR" : "TREE") << std::endl;
+    }
+
+    if (key == GLFW_KEY_F5 && action == GLFW_PRESS) {
+        g_use_instancing = !g_use_instancing;
+        std::cout << "Instanced rendering: " << (g_use_instancing ? "ON" : "OFF") << std::endl;
+    }
+
+    if (key == GLFW_KEY_F6 && action == GLFW_PRESS) {
+        g_use_culling = !g_use_culling;
+        std::cout << "Frustum culling: " << (g_use_culling ? "ON" : "OFF") << std::endl;
+    }
+
+    if (key == GLFW_KEY_F7 && action == GLFW_PRESS) {
+        g_use_lod = !g_use_lod;
+        std::cout << "Level of detail: " << (g_use_lod ? "ON" : "OFF") << std::endl;
+    }
+
+    if (key == GLFW_KEY_F8 && action == GLFW_PRESS) {
+        Broadphase& broadphase = g_simulation->broadphase;
+        broadphase = broadphase == Broadphase::GRID ? Broadphase::BVH
+                   : broadphase == Broadphase::BVH ? Broadphase::BRUTE_FORCE
+                   : Broadphase::GRID;
+        std::cout << "Collision broadphase: " << GetBroadphaseName(broadphase) << std::endl;
+    }
+
+    if (key == GLFW_KEY_F9 && action == GLFW_PRESS) {
+        g_simulation->use_swept_collision = !g_simulation->use_swept_collision;
+        std::cout << "Swept projectile collision: " << (g_simulation->use_swept_collision ? "ON" : "OFF") << std::endl;
+    }
+
     // Only allow ship controls during gameplay
     if (g_game_manager->current_state != GameState::PLAYING) return;
 
+    ShipMotion& motion = g_simulation->ship_motion;
+    glm::quat& orientation = g_simulation->ship_transform.orientation;
+
     // Ship movement
-    if (key == GLFW_KEY_W) g_ship->moving_forward = (action != GLFW_RELEASE);
-    if (key == GLFW_KEY_S) g_ship->moving_backward = (action != GLFW_RELEASE);
-    if (key == GLFW_KEY_A) g_ship->moving_left = (action != GLFW_RELEASE);
-    if (key == GLFW_KEY_D) g_ship->moving_right = (action != GLFW_RELEASE);
+    if (key == GLFW_KEY_W) motion.moving_forward = (action != GLFW_RELEASE);
+    if (key == GLFW_KEY_S) motion.moving_backward = (action != GLFW_RELEASE);
+    if (key == GLFW_KEY_A) motion.moving_left = (action != GLFW_RELEASE);
+    if (key == GLFW_KEY_D) motion.moving_right = (action != GLFW_RELEASE);
 
     // Fire laser
     if (key == GLFW_KEY_SPACE && action == GLFW_PRESS) {
-        Laser* laser = nullptr;
-        for (auto l : g_lasers) {
-            if (!l->active) {
-                laser = l;
-                break;
-            }
-        }
-        if (!laser) {
-            laser = new Laser();
-            laser->model = CreateCube(1.0f, glm::vec3(1.0f, 0.0f, 0.0f));
-            g_lasers.push_back(laser);
-            g_root->AddChild(laser);
-        }
-
-        glm::vec3 fire_pos = g_ship->position + g_ship->GetForward() * 2.0f;
-        laser->Fire(fire_pos, g_ship->orientation);
+        g_simulation->FireLaser();
     }
 
     // Fire missile
     if (key == GLFW_KEY_M && action == GLFW_PRESS) {
-        Missile* missile = nullptr;
-        for (auto m : g_missiles) {
-            if (!m->active) {
-                missile = m;
-                break;
-            }
-        }
-        if (!missile) {
-            missile = new Missile();
-            missile->model = CreateCylinder(0.5f, 1.0f, 8, glm::vec3(1.0f, 1.0f, 0.0f));
-            g_missiles.push_back(missile);
-            g_root->AddChild(missile);
-        }
-
-        glm::vec3 fire_pos = g_ship->position + g_ship->GetForward() * 2.0f;
-        missile->Fire(fire_pos, g_ship->orientation);
+        g_simulation->FireMissile();
     }
 
     // Ship rotation
     if (key == GLFW_KEY_UP) {
         glm::quat rotation = glm::angleAxis(glm::radians(2.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        g_ship->orientation = rotation * g_ship->orientation;
+        orientation = rotation * orientation;
     }
     if (key == GLFW_KEY_DOWN) {
         glm::quat rotation = glm::angleAxis(glm::radians(-2.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-        g_ship->orientation = rotation * g_ship->orientation;
+        orientation = rotation * orientation;
     }
     if (key == GLFW_KEY_LEFT) {
         glm::quat rotation = glm::angleAxis(glm::radians(2.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-        g_ship->orientation = rotation * g_ship->orientation;
+        orientation = rotation * orientation;
     }
     if (key == GLFW_KEY_RIGHT) {
         glm::quat rotation = glm::angleAxis(glm::radians(-2.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-        g_ship->orientation = rotation * g_ship->orientation;
+        orientation = rotation * orientation;
     }
 }
 
 void ResizeCallback(GLFWwindow* window, int width, int height) {
     glViewport(0, 0, width, height);
+    g_viewport_width = width;
+    g_viewport_height = height;
     float aspect = (float)width / (float)height;
     g_projection_matrix = glm::perspective(glm::radians(camera_fov_g), aspect, camera_near_clip_distance_g, camera_far_clip_distance_g);
 }
 
-// Game logic update
+// Broadphase, narrowphase and (for the batched kernel) SIMD level, for the debug overlay
+std::string GetCollisionModeName() {
+    std::string name = GetBroadphaseName(g_simulation->broadphase);
+    if (g_simulation->use_swept_collision) {
+        name += ", SWEPT";
+        if (g_simulation->broadphase == Broadphase::BRUTE_FORCE) {
+            name += std::string(", ") + GetSimdLevelName(g_simulation->simd_level);
+        }
+    } else {
+        name += ", LINE";
+    }
+    return name;
+}
+
+// Float a "+points" popup at the screen position of a world-space point.
+// Called inside a step, after the camera moved, so the view matrix is
+// computed from the camera's current pose rather than last frame's cache.
+void ShowScorePopupAt(const glm::vec3& point, int points) {
+    if (!g_enhanced_hud) return;
+    glm::vec4 clip = g_projection_matrix * g_camera->ComputeViewMatrix() * glm::vec4(point, 1.0f);
+    if (clip.w <= 0.0f) return;  // Behind the camera
+    float x = (clip.x / clip.w * 0.5f + 0.5f) * window_width_g;
+    float y = (clip.y / clip.w * 0.5f + 0.5f) * window_height_g;
+    g_enhanced_hud->ShowScorePopup(points, x, y);
+}
+
+// Game logic update: one simulation step, then the camera, particles and
+// the explosions and HUD feedback for the collisions it applied
 void UpdateGame(float delta_time) {
     if (g_game_manager->current_state != GameState::PLAYING) {
         return;
     }
 
-    g_game_manager->game_time += delta_time;
-    g_ship->Update(delta_time);
-    g_camera->UpdateCameraPosition(g_ship);
+    g_simulation->Step(delta_time);
+    g_simulation->SyncNodes();
+    g_camera->UpdateCameraPosition(g_simulation->ship);
     g_particle_system->Update(static_cast<float>(glfwGetTime()));
 
-    // Update lasers and check collisions
-    for (auto laser : g_lasers) {
-        if (laser->active) {
-            laser->Update(delta_time);
-            for (auto asteroid : g_asteroids) {
-                if (asteroid->visible && !asteroid->hit) {
-                    if (asteroid->CheckRayIntersection(laser->GetRayStart(), laser->GetRayDirection())) {
-                        asteroid->hit = true;
-                        asteroid->visible = false;
-                        laser->active = false;
-                        laser->visible = false;
-                        g_game_manager->AddScore(100);
-                        g_particle_system->SpawnExplosion(asteroid->position, glm::vec3(1.0f, 0.5f, 0.0f));
-                        break;
-                    }
-                }
-            }
-        }
-    }
-
-    // Update missiles and check collisions
-    for (auto missile : g_missiles) {
-        if (missile->active) {
-            missile->Update(delta_time);
-            for (auto asteroid : g_asteroids) {
-                if (asteroid->visible && !asteroid->hit) {
-                    if (asteroid->CheckRayIntersection(missile->GetRayStart(), missile->GetRayDirection())) {
-                        asteroid->hit = true;
-                        asteroid->visible = false;
-                        missile->active = false;
-                        missile->visible = false;
-                        g_game_manager->AddScore(150);
-                        g_particle_system->SpawnExplosion(asteroid->position, glm::vec3(1.0f, 0.7f, 0.0f));
-                        break;
-                    }
+    for (const CollisionEvent& event : g_simulation->events) {
+        const glm::vec3* asteroid = g_simulation->GetPosition(event.asteroid);
+        if (!asteroid) continue;
+        glm::vec3 position = *asteroid;
+        switch (event.type) {
+            case CollisionType::LASER_ASTEROID:
+                ShowScorePopupAt(event.point, 100);
+                g_particle_system->SpawnExplosion(position, glm::vec3(1.0f, 0.5f, 0.0f));
+                break;
+            case CollisionType::MISSILE_ASTEROID:
+                ShowScorePopupAt(event.point, 150);
+                g_particle_system->SpawnExplosion(position, glm::vec3(1.0f, 0.7f, 0.0f));
+                break;
+            case CollisionType::SHIP_ASTEROID:
+                if (g_enhanced_hud) {
+                    g_enhanced_hud->TriggerDamageFlash();
                 }
-            }
-        }
-    }
-
-    // Update asteroids and check ship collision
-    for (auto asteroid : g_asteroids) {
-        if (asteroid->visible) {
-            glm::quat rotation = glm::angleAxis(delta_time * 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
-            asteroid->orientation = asteroid->orientation * rotation;
-
-            // Check ship collision
-            float ship_radius = 1.5f;
-            if (asteroid->CheckMissileIntersection(g_ship->position, ship_radius)) {
-                asteroid->hit = true;
-                asteroid->visible = false;
-                g_game_manager->TakeDamage(20);
-                g_particle_system->SpawnExplosion(asteroid->position, glm::vec3(1.0f, 0.3f, 0.0f));
-            }
+                g_particle_system->SpawnExplosion(position, glm::vec3(1.0f, 0.3f, 0.0f));
+                break;
         }
     }
-
-    // Update cannon animation
-    if (g_cannon_root) {
-        double current_time = glfwGetTime();
-        glm::quat cannon_rotation = glm::angleAxis((float)current_time * 0.3f, glm::vec3(0.0f, 1.0f, 0.0f));
-        g_cannon_root->orientation = cannon_rotation;
-    }
 }
 
 // Initialize scene
 void InitializeScene() {
-    g_root = new SceneNode("Root");
+    // Initialize game systems (only once)
+    if (!g_game_manager) {
+        g_game_manager = new GameManager();
+        g_job_system = new JobSystem(g_thread_count);
+        g_simulation = new Simulation(g_game_manager, g_job_system, g_run_seed);
+        g_hud = new HUD();
+        g_starfield = new Starfield(g_run_seed, 1000);
+        g_particle_system = new ParticleSystem(g_run_seed, 500);
+    }
 
-    // Create ship
-    g_ship = new Ship();
-    g_ship->position = glm::vec3(0.0f, 0.0f, 0.0f);
-    g_root->AddChild(g_ship);
+    // Build the world, then give its nodes meshes and visual children
+    g_simulation->field_layout = g_field_layout;
+    g_simulation->CreateWorld(g_asteroid_count);
+    SceneNode* ship = g_simulation->ship;
 
     // Ship body
     SceneNode* ship_body = new SceneNode("ShipBody");
-    ship_body->model = CreateCube(1.0f, glm::vec3(0.2f, 0.5f, 0.9f));
-    ship_body->scale = glm::vec3(1.0f, 0.8f, 2.5f);
-    g_ship->AddChild(ship_body);
+    ship_body->SetModel(g_mesh_registry->AcquireCube(1.0f));
+    ship_body->SetColor(glm::vec3(0.2f, 0.5f, 0.9f));
+    ship_body->SetScale(glm::vec3(1.0f, 0.8f, 2.5f));
+    ship->AddChild(ship_body);
 
     // Ship nose
     SceneNode* ship_nose = new SceneNode("ShipNose");
-    ship_nose->model = CreateCube(0.6f, glm::vec3(0.3f, 0.8f, 1.0f));
-    ship_nose->position = glm::vec3(0.0f, 0.2f, -1.5f);
-    ship_nose->scale = glm::vec3(0.7f, 0.7f, 0.6f);
-    g_ship->AddChild(ship_nose);
+    ship_nose->SetModel(g_mesh_registry->AcquireCube(0.6f));
+    ship_nose->SetColor(glm::vec3(0.3f, 0.8f, 1.0f));
+    ship_nose->SetPosition(glm::vec3(0.0f, 0.2f, -1.5f));
+    ship_nose->SetScale(glm::vec3(0.7f, 0.7f, 0.6f));
+    ship->AddChild(ship_nose);
 
     // Wings
     SceneNode* left_wing = new SceneNode("LeftWing");
-    left_wing->model = CreateCube(0.5f, glm::vec3(0.4f, 0.6f, 0.8f));
-    left_wing->position = glm::vec3(-1.2f, 0.0f, 0.3f);
-    left_wing->scale = glm::vec3(2.0f, 0.2f, 1.5f);
-    g_ship->AddChild(left_wing);
+    left_wing->SetModel(g_mesh_registry->AcquireCube(0.5f));
+    left_wing->SetColor(glm::vec3(0.4f, 0.6f, 0.8f));
+    left_wing->SetPosition(glm::vec3(-1.2f, 0.0f, 0.3f));
+    left_wing->SetScale(glm::vec3(2.0f, 0.2f, 1.5f));
+    ship->AddChild(left_wing);
 
     SceneNode* right_wing = new SceneNode("RightWing");
-    right_wing->model = CreateCube(0.5f, glm::vec3(0.4f, 0.6f, 0.8f));
-    right_wing->position = glm::vec3(1.2f, 0.0f, 0.3f);
-    right_wing->scale = glm::vec3(2.0f, 0.2f, 1.5f);
-    g_ship->AddChild(right_wing);
+    right_wing->SetModel(g_mesh_registry->AcquireCube(0.5f));
+    right_wing->SetColor(glm::vec3(0.4f, 0.6f, 0.8f));
+    right_wing->SetPosition(glm::vec3(1.2f, 0.0f, 0.3f));
+    right_wing->SetScale(glm::vec3(2.0f, 0.2f, 1.5f));
+    ship->AddChild(right_wing);
 
     // Engines
     SceneNode* engine_left = new SceneNode("EngineLeft");
-    engine_left->model = CreateCube(0.3f, glm::vec3(1.0f, 0.5f, 0.0f));
-    engine_left->position = glm::vec3(-0.5f, 0.0f, 1.3f);
-    engine_left->scale = glm::vec3(0.4f, 0.4f, 0.4f);
-    g_ship->AddChild(engine_left);
+    engine_left->SetModel(g_mesh_registry->AcquireCube(0.3f));
+    engine_left->SetColor(glm::vec3(1.0f, 0.5f, 0.0f));
+    engine_left->SetPosition(glm::vec3(-0.5f, 0.0f, 1.3f));
+    engine_left->SetScale(glm::vec3(0.4f, 0.4f, 0.4f));
+    ship->AddChild(engine_left);
 
     SceneNode* engine_right = new SceneNode("EngineRight");
-    engine_right->model = CreateCube(0.3f, glm::vec3(1.0f, 0.5f, 0.0f));
-    engine_right->position = glm::vec3(0.5f, 0.0f, 1.3f);
-    engine_right->scale = glm::vec3(0.4f, 0.4f, 0.4f);
-    g_ship->AddChild(engine_right);
+    engine_right->SetModel(g_mesh_registry->AcquireCube(0.3f));
+    engine_right->SetColor(glm::vec3(1.0f, 0.5f, 0.0f));
+    engine_right->SetPosition(glm::vec3(0.5f, 0.0f, 1.3f));
+    engine_right->SetScale(glm::vec3(0.4f, 0.4f, 0.4f));
+    ship->AddChild(engine_right);
 
     // Create camera
     g_camera = new Camera();
-    g_ship->AddChild(g_camera);
-
-    // Create asteroids
-    for (int i = 0; i < 15; i++) {
-        Asteroid* asteroid = new Asteroid();
-        float angle = (float)i / 15.0f * 2.0f * glm::pi<float>();
-        float distance = 20.0f + (i % 3) * 15.0f;
-        asteroid->position = glm::vec3(cos(angle) * distance, (rand() % 20 - 10) * 0.5f, sin(angle) * distance);
-        asteroid->scale = glm::vec3(1.5f);
-
-        float hue = (float)i / 15.0f * 360.0f;
-        glm::vec3 ast_color = HSVtoRGB(hue, 0.8f, 0.9f);
-        asteroid->model = CreateSphere(1.0f, 12, 24, ast_color);
-        g_asteroids.push_back(asteroid);
-        g_root->AddChild(asteroid);
+    ship->AddChild(g_camera);
+
+    // Asteroids
+    int asteroid_count = static_cast<int>(g_simulation->asteroids.GetCount());
+    for (int i = 0; i < asteroid_count; i++) {
+        SceneNode* asteroid = g_simulation->asteroids.nodes[i];
+        float hue = (float)i / (float)asteroid_count * 360.0f;
+        asteroid->SetLod(g_mesh_registry->AcquireSphereLod(1.0f, 12, 24));
+        asteroid->SetModel(asteroid->GetLod()->levels[0]);
+        asteroid->SetColor(HSVtoRGB(hue, 0.8f, 0.9f));
     }
 
-    // Create cannon
-    g_cannon_root = new SceneNode("CannonBase");
-    g_cannon_root->position = glm::vec3(-30.0f, 0.0f, 0.0f);
+    // Cannon
+    SceneNode* cannon_root = g_simulation->cannon_root;
 
     SceneNode* cannon_base = new SceneNode("CannonBaseCylinder");
-    cannon_base->model = CreateCylinder(2.0f, 0.8f, 32, glm::vec3(0.5f, 0.5f, 0.5f));
-    g_cannon_root->AddChild(cannon_base);
+    cannon_base->SetLod(g_mesh_registry->AcquireCylinderLod(2.0f, 0.8f, 32));
+    cannon_base->SetModel(cannon_base->GetLod()->levels[0]);
+    cannon_base->SetColor(glm::vec3(0.5f, 0.5f, 0.5f));
+    cannon_root->AddChild(cannon_base);
 
     SceneNode* cannon_barrel = new SceneNode("CannonBarrel");
-    cannon_barrel->position = glm::vec3(0.0f, 1.0f, 0.0f);
-    cannon_barrel->orientation = glm::angleAxis(glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
-    cannon_barrel->model = CreateCylinder(0.6f, 4.0f, 16, glm::vec3(0.3f, 0.3f, 0.3f));
-    g_cannon_root->AddChild(cannon_barrel);
+    cannon_barrel->SetPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    cannon_barrel->SetOrientation(glm::angleAxis(glm::radians(90.0f), glm::vec3(1.0f, 0.0f, 0.0f)));
+    cannon_barrel->SetLod(g_mesh_registry->AcquireCylinderLod(0.6f, 4.0f, 16));
+    cannon_barrel->SetModel(cannon_barrel->GetLod()->levels[0]);
+    cannon_barrel->SetColor(glm::vec3(0.3f, 0.3f, 0.3f));
+    cannon_root->AddChild(cannon_barrel);
+
+    // Projectile pools; every slot shares one mesh, so firing never touches the GPU
+    for (SceneNode* laser : g_simulation->lasers.nodes) {
+        laser->SetModel(g_mesh_registry->AcquireCube(1.0f));
+        laser->SetColor(glm::vec3(1.0f, 0.0f, 0.0f));
+    }
+    for (SceneNode* missile : g_simulation->missiles.nodes) {
+        missile->SetModel(g_mesh_registry->AcquireCylinder(0.5f, 1.0f, 8));
+        missile->SetColor(glm::vec3(1.0f, 1.0f, 0.0f));
+    }
 
-    g_root->AddChild(g_cannon_root);
+    // New nodes start at rest for render interpolation
+    g_simulation->root->SaveSimulationState();
+}
 
-    // Initialize game systems (only once)
-    if (!g_game_manager) {
-        g_game_manager = new GameManager();
-        g_hud = new HUD();
-        g_starfield = new Starfield(1000);
-        g_particle_system = new ParticleSystem(500);
+// Record the pose every node is drawn from until the next step. A current
+// linear scene copies its arrays; otherwise the tree is walked.
+void SaveRenderState() {
+    SceneNode* root = g_simulation->root;
+    if (g_use_linear_scene && !g_linear_scene.NeedsRebuild(root)) {
+        g_linear_scene.SaveSimulationState();
+    } else {
+        root->SaveSimulationState();
     }
 }
 
-int main(void) {
+// Start a new game on the existing scene: the simulation resets its
+// entities and the existing nodes are moved to match, so no node, mesh or
+// GPU buffer is created or freed
+void RestartGame() {
+    double start = glfwGetTime();
+    g_simulation->ResetWorld();
+    g_simulation->SyncNodes();
+    SaveRenderState();  // Teleported; nothing interpolates from its old pose
+    g_particle_system->Clear();
+    std::cout << "Scene reset in " << (glfwGetTime() - start) * 1000.0 << " ms" << std::endl;
+    g_game_manager->StartGame();
+}
+
+// Tear down the scene graph and hand its meshes back to the registry
+void DestroyScene() {
+    g_linear_scene.Clear();
+    g_mesh_registry->ReleaseTree(g_simulation->root);
+    g_simulation->DestroyWorld();
+}
+
+int main(int argc, char** argv) {
     try {
+        // Parse command line options
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            if (arg == "--asteroids" && i + 1 < argc) {
+                g_asteroid_count = std::max(1, std::atoi(argv[++i]));
+                g_field_layout = FieldLayout::RINGS;
+            } else if (arg == "--benchmark") {
+                g_benchmark = true;
+            } else if (arg == "--tick-rate" && i + 1 < argc) {
+                g_tick_rate = std::max(1, std::atoi(argv[++i]));
+                g_fixed_step = 1.0f / static_cast<float>(g_tick_rate);
+            } else if (arg == "--seed" && i + 1 < argc) {
+                g_run_seed = ParseSeed(argv[++i]);
+            } else if (arg == "--threads" && i + 1 < argc) {
+                g_thread_count = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+            } else {
+                throw(std::runtime_error("Unknown argument: " + arg));
+            }
+        }
+
         // Initialize GLFW
         if (!glfwInit()) {
             throw(std::runtime_error("Could not initialize GLFW"));
@@ -510,44 +664,11 @@ int main(void) {
         glCullFace(GL_BACK);
 
         // Create shaders
-        GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vs, 1, &source_vp, NULL);
-        glCompileShader(vs);
-
-        GLint status;
-        glGetShaderiv(vs, GL_COMPILE_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetShaderInfoLog(vs, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error compiling vertex shader: ") + buffer));
-        }
-
-        GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fs, 1, &source_fp, NULL);
-        glCompileShader(fs);
-
-        glGetShaderiv(fs, GL_COMPILE_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetShaderInfoLog(fs, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error compiling fragment shader: ") + buffer));
+        g_program = new ShaderProgram();
+        if (!g_program->Load(source_vp, source_fp)) {
+            throw(std::runtime_error(g_program->GetLog()));
         }
 
-        g_program = glCreateProgram();
-        glAttachShader(g_program, vs);
-        glAttachShader(g_program, fs);
-        glLinkProgram(g_program);
-
-        glGetProgramiv(g_program, GL_LINK_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetProgramInfoLog(g_program, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error linking shaders: ") + buffer));
-        }
-
-        glDeleteShader(vs);
-        glDeleteShader(fs);
-
         // Create particle shader program with geometry shader
         // Particle rendering based on Prof. Azami's ParticleDemo
         std::cout << "Loading particle shaders..." << std::endl;
@@ -556,61 +677,24 @@ int main(void) {
         std::string particle_gp_source = LoadShaderFile("shaders/particle_gp.glsl");
         std::string particle_fp_source = LoadShaderFile("shaders/particle_fp.glsl");
 
-        const char* particle_vp_c = particle_vp_source.c_str();
-        const char* particle_gp_c = particle_gp_source.c_str();
-        const char* particle_fp_c = particle_fp_source.c_str();
-
-        GLuint particle_vs = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(particle_vs, 1, &particle_vp_c, NULL);
-        glCompileShader(particle_vs);
-
-        glGetShaderiv(particle_vs, GL_COMPILE_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetShaderInfoLog(particle_vs, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error compiling particle vertex shader: ") + buffer));
+        g_particle_program = new ShaderProgram();
+        if (!g_particle_program->Load(particle_vp_source.c_str(), particle_fp_source.c_str(),
+                                      particle_gp_source.c_str())) {
+            throw(std::runtime_error("Particle shaders: " + g_particle_program->GetLog()));
         }
 
-        GLuint particle_gs = glCreateShader(GL_GEOMETRY_SHADER);
-        glShaderSource(particle_gs, 1, &particle_gp_c, NULL);
-        glCompileShader(particle_gs);
-
-        glGetShaderiv(particle_gs, GL_COMPILE_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetShaderInfoLog(particle_gs, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error compiling particle geometry shader: ") + buffer));
-        }
-
-        GLuint particle_fs = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(particle_fs, 1, &particle_fp_c, NULL);
-        glCompileShader(particle_fs);
-
-        glGetShaderiv(particle_fs, GL_COMPILE_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetShaderInfoLog(particle_fs, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error compiling particle fragment shader: ") + buffer));
-        }
+        std::cout << "Particle shaders loaded successfully!" << std::endl;
 
-        g_particle_program = glCreateProgram();
-        glAttachShader(g_particle_program, particle_vs);
-        glAttachShader(g_particle_program, particle_gs);
-        glAttachShader(g_particle_program, particle_fs);
-        glLinkProgram(g_particle_program);
-
-        glGetProgramiv(g_particle_program, GL_LINK_STATUS, &status);
-        if (status != GL_TRUE) {
-            char buffer[512];
-            glGetProgramInfoLog(g_particle_program, 512, NULL, buffer);
-            throw(std::runtime_error(std::string("Error linking particle shaders: ") + buffer));
+        g_instanced_program = new ShaderProgram();
+        if (!g_instanced_program->Load(source_instanced_vp, source_fp)) {
+            throw(std::runtime_error("Instanced shaders: " + g_instanced_program->GetLog()));
         }
 
-        glDeleteShader(particle_vs);
-        glDeleteShader(particle_gs);
-        glDeleteShader(particle_fs);
+        g_instanced_renderer = new InstancedRenderer();
+        g_instanced_renderer->Initialize();
 
-        std::cout << "Particle shaders loaded successfully!" << std::endl;
+        g_frame_uniforms = new FrameUniforms();
+        g_frame_uniforms->Initialize();
 
         // Set up projection
         float aspect = (float)window_width_g / (float)window_height_g;
@@ -623,8 +707,14 @@ int main(void) {
         glfwSetMouseButtonCallback(window, MouseButtonCallback);
 
         // Initialize scene
+        g_mesh_registry = new MeshRegistry();
         InitializeScene();
 
+        // The simulation picks the widest collision kernel this CPU runs
+        std::cout << "Collision SIMD level: " << GetSimdLevelName(g_simulation->simd_level) << std::endl;
+        std::cout << "Run seed: " << g_run_seed << std::endl;
+        std::cout << "Simulation threads: " << g_job_system->GetThreadCount() << std::endl;
+
         // Initialize Menu System
         g_menu_manager = new MenuManager(window_width_g, window_height_g);
         if (!g_menu_manager->Initialize()) {
@@ -647,10 +737,7 @@ int main(void) {
         });
 
         g_menu_manager->SetRestartGameCallback([&]() {
-            g_asteroids.clear();
-            delete g_root;
-            InitializeScene();
-            g_game_manager->StartGame();
+            RestartGame();
             g_menu_manager->SetCurrentMenu(MenuState::NONE);
         });
 
@@ -676,6 +763,13 @@ int main(void) {
         std::cout << "  C          - Toggle camera" << std::endl;
         std::cout << "  P          - Pause/Resume" << std::endl;
         std::cout << "  R          - Restart (when game over)" << std::endl;
+        std::cout << "  F3         - Toggle debug statistics" << std::endl;
+        std::cout << "  F4         - Toggle flattened scene traversal" << std::endl;
+        std::cout << "  F5         - Toggle instanced rendering" << std::endl;
+        std::cout << "  F6         - Toggle frustum culling" << std::endl;
+        std::cout << "  F7         - Toggle level of detail" << std::endl;
+        std::cout << "  F8         - Cycle collision broadphase" << std::endl;
+        std::cout << "  F9         - Toggle swept projectile collision" << std::endl;
         std::cout << "  Q          - Quit" << std::endl;
         std::cout << "\nObjective: Destroy asteroids! Avoid collisions!" << std::endl;
         std::cout << "========================================\n" << std::endl;
@@ -683,6 +777,17 @@ int main(void) {
         // Show menu
         g_hud->RenderMenu();
 
+        // Benchmark runs skip the menu and report frame statistics once per second
+        if (g_benchmark) {
+            g_game_manager->StartGame();
+            g_menu_manager->SetCurrentMenu(MenuState::NONE);
+            std::cout << "Benchmark: " << g_simulation->asteroids.GetCount()
+                      << (g_field_layout == FieldLayout::STREAMED ? " streamed asteroid rows" : " asteroids")
+                      << ", seed " << g_run_seed << std::endl;
+        }
+        double benchmark_start = glfwGetTime();
+        unsigned int benchmark_frames = 0;
+
         g_last_time = glfwGetTime();
 
         // Main loop
@@ -691,35 +796,103 @@ int main(void) {
             float delta_time = (float)(current_time - g_last_time);
             g_last_time = current_time;
 
+            g_frame_name_lookups = ShaderProgram::GetNameLookups();
+            ShaderProgram::ResetNameLookups();
+
             glClearColor(viewport_background_color_g[0], viewport_background_color_g[1], viewport_background_color_g[2], 1.0);
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-            UpdateGame(delta_time);
+            // Run as many fixed simulation steps as the elapsed time covers
+            g_accumulator += std::min(delta_time, MAX_FRAME_TIME);
+            g_frame_steps = 0;
+            while (g_accumulator >= g_fixed_step && g_frame_steps < MAX_STEPS_PER_FRAME) {
+                SaveRenderState();
+                UpdateGame(g_fixed_step);
+                g_accumulator -= g_fixed_step;
+                g_frame_steps++;
+            }
+            if (g_frame_steps == MAX_STEPS_PER_FRAME) {
+                g_accumulator = std::fmod(g_accumulator, g_fixed_step);
+            }
 
-            glUseProgram(g_program);
+            // Hide ship during menu, otherwise show based on camera mode. Set before
+            // the update below, which leaves hidden nodes out of the culling bounds.
+            if (g_game_manager->current_state == GameState::MENU) {
+                g_simulation->ship->SetVisible(false);
+            } else {
+                g_simulation->ship->SetVisible(!g_camera->is_first_person);
+            }
 
-            glm::mat4 view_matrix = g_camera->GetViewMatrix();
-            GLint view_mat = glGetUniformLocation(g_program, "view_mat");
-            glUniformMatrix4fv(view_mat, 1, GL_FALSE, glm::value_ptr(view_matrix));
+            // Draw the scene the fraction of a step past the last simulated state,
+            // refreshing cached world matrices once, after all movement for this frame
+            SceneNode* root = g_simulation->root;
+            float alpha = g_accumulator / g_fixed_step;
+            bool linear_scene = g_use_linear_scene;
+            SceneNode::ResetTransformStats();
+            if (linear_scene) {
+                if (g_linear_scene.NeedsRebuild(root)) {
+                    g_linear_scene.Build(root);
+                }
+                g_linear_scene.UpdateTransforms(alpha);
+            } else {
+                root->BeginInterpolation(alpha);
+                root->UpdateTransforms();
+            }
 
-            GLint projection_mat = glGetUniformLocation(g_program, "projection_mat");
-            glUniformMatrix4fv(projection_mat, 1, GL_FALSE, glm::value_ptr(g_projection_matrix));
+            // Upload camera and viewport data once for all shader programs
+            glm::mat4 view_matrix = g_camera->GetViewMatrix();
+            FrameData frame_data;
+            frame_data.view = view_matrix;
+            frame_data.projection = g_projection_matrix;
+            frame_data.view_projection = g_projection_matrix * view_matrix;
+            frame_data.ui_projection = glm::ortho(0.0f, (float)window_width_g, 0.0f, (float)window_height_g);
+            frame_data.camera_position = glm::inverse(view_matrix)[3];
+            frame_data.viewport = glm::vec4((float)g_viewport_width, (float)g_viewport_height,
+                                            1.0f / std::max(g_viewport_width, 1), 1.0f / std::max(g_viewport_height, 1));
+            frame_data.time = static_cast<float>(current_time);
+            frame_data.delta_time = delta_time;
+            g_frame_uniforms->Update(frame_data);
+
+            g_program->Use();
 
             // Render starfield first
-            g_starfield->Render(g_program);
+            g_starfield->Render(g_program->GetId());
 
-            // Hide ship during menu, otherwise show based on camera mode
-            if (g_game_manager->current_state == GameState::MENU) {
-                g_ship->visible = false;
+            // Render scene; instanced nodes are collected and drawn in one batch per mesh
+            Frustum frustum;
+            frustum.Extract(frame_data.view_projection);
+
+            RenderContext render_context;
+            render_context.program = g_program;
+            if (g_use_culling) {
+                render_context.frustum = &frustum;
+            }
+            if (g_use_lod) {
+                // Pixels per world unit at distance 1 along the view axis
+                render_context.camera_position = glm::vec3(frame_data.camera_position);
+                render_context.lod_scale = g_projection_matrix[1][1] * g_viewport_height * 0.5f;
+            }
+            if (g_use_instancing) {
+                render_context.instancing = g_instanced_renderer;
+                g_instanced_renderer->Begin();
+            }
+            if (linear_scene) {
+                g_linear_scene.BuildDrawList(render_context.frustum);
+                g_linear_scene.Draw(render_context);
             } else {
-                g_ship->visible = !g_camera->is_first_person;
+                root->Draw(render_context);
             }
+            glBindVertexArray(0);
 
-            // Render scene
-            g_root->Draw(g_program);
+            unsigned int instance_count = 0;
+            if (g_use_instancing) {
+                g_instanced_renderer->Flush(*g_instanced_program);
+                render_context.draw_calls += g_instanced_renderer->GetDrawCalls();
+                instance_count = g_instanced_renderer->GetInstanceCount();
+            }
 
             // Render particles
-            g_particle_system->Render(static_cast<float>(current_time), view_matrix, g_projection_matrix);
+            g_particle_system->Render(static_cast<float>(current_time));
 
             // Handle different game states
             switch (g_game_manager->current_state) {
@@ -730,6 +903,48 @@ int main(void) {
                     break;
                 case GameState::PLAYING:
                     if (g_enhanced_hud) {
+                        if (g_enhanced_hud->IsDebugInfoVisible()) {
+                            std::vector<std::string> debug_lines;
+                            debug_lines.push_back("MATRICES REBUILT: " + std::to_string(SceneNode::GetTransformsRebuilt()));
+                            debug_lines.push_back("SHADER NAME LOOKUPS: " + std::to_string(g_frame_name_lookups));
+                            debug_lines.push_back("MESHES: " + std::to_string(g_mesh_registry->GetMeshCount()) + " (" +
+                                                  std::to_string(g_mesh_registry->GetBufferBytes() / 1024) + " KB)");
+                            debug_lines.push_back("DRAW CALLS: " + std::to_string(render_context.draw_calls));
+                            debug_lines.push_back("COLLISION TESTS: " + std::to_string(g_simulation->collision_tests) +
+                                                  " (" + GetCollisionModeName() + ")");
+                            debug_lines.push_back("SIMULATION: " + std::to_string(g_tick_rate) + " HZ, " +
+                                                  std::to_string(g_frame_steps) + " STEPS THIS FRAME, " +
+                                                  std::to_string(g_job_system->GetThreadCount()) + " THREADS");
+                            debug_lines.push_back("COLLISION EVENTS: " + std::to_string(g_simulation->events.size()) +
+                                                  ", DETECT " + std::to_string(static_cast<int>(g_simulation->detect_microseconds)) +
+                                                  " US, RESOLVE " + std::to_string(static_cast<int>(g_simulation->resolve_microseconds)) + " US");
+                            if (g_field_layout == FieldLayout::STREAMED) {
+                                debug_lines.push_back("FIELD: " + std::to_string(g_simulation->field.GetResidentCount()) +
+                                                      " CHUNKS RESIDENT, " + std::to_string(g_simulation->field.GetChunksGenerated()) +
+                                                      " GENERATED, LAST " + std::to_string(g_simulation->field_chunks_loaded) +
+                                                      " IN " + std::to_string(static_cast<int>(g_simulation->field_generate_microseconds)) + " US");
+                            } else {
+                                debug_lines.push_back("FIELD: RINGS, " + std::to_string(g_simulation->asteroids.GetCount()) + " ASTEROIDS");
+                            }
+                            debug_lines.push_back("PROJECTILES: " + std::to_string(g_simulation->laser_pool.GetActiveCount()) + "/" +
+                                                  std::to_string(g_simulation->laser_pool.GetCapacity()) + " LASERS, " +
+                                                  std::to_string(g_simulation->missile_pool.GetActiveCount()) + "/" +
+                                                  std::to_string(g_simulation->missile_pool.GetCapacity()) + " MISSILES");
+                            debug_lines.push_back("TRIANGLES: " + std::to_string(render_context.triangles) +
+                                                  (g_use_lod ? "" : " (LOD OFF)"));
+                            debug_lines.push_back("NODES: " + std::to_string(render_context.nodes_drawn) + " DRAWN, " +
+                                                  std::to_string(render_context.nodes_culled) + " CULLED" +
+                                                  (g_use_culling ? "" : " (OFF)"));
+                            debug_lines.push_back("INSTANCES: " + std::to_string(instance_count) +
+                                                  (g_use_instancing ? "" : " (OFF)"));
+                            if (g_use_linear_scene) {
+                                debug_lines.push_back("SCENE: LINEAR " + std::to_string(g_linear_scene.GetNodeCount()) +
+                                                      " NODES, " + std::to_string(g_linear_scene.GetDrawCount()) + " DRAWN");
+                            } else {
+                                debug_lines.push_back("SCENE: TREE");
+                            }
+                            g_enhanced_hud->SetDebugLines(debug_lines);
+                        }
                         g_enhanced_hud->UpdatePopups(delta_time);
                         g_enhanced_hud->SetHealth(g_game_manager->health);
                         g_enhanced_hud->SetMaxHealth(g_game_manager->max_health);
@@ -758,12 +973,38 @@ int main(void) {
                     break;
             }
 
+            // Input handlers and the next steps work on the simulated poses
+            if (!linear_scene) {
+                root->EndInterpolation();
+            }
+
             glfwSwapBuffers(window);
             glfwPollEvents();
+
+            if (g_benchmark) {
+                benchmark_frames++;
+                double elapsed = glfwGetTime() - benchmark_start;
+                if (elapsed >= 1.0) {
+                    std::cout << "asteroids " << g_simulation->asteroids.GetCount()
+                              << " | draw calls " << render_context.draw_calls
+                              << " | instances " << instance_count
+                              << " | drawn " << render_context.nodes_drawn
+                              << " | culled " << render_context.nodes_culled
+                              << " | triangles " << render_context.triangles
+                              << " | frame " << (elapsed * 1000.0 / benchmark_frames) << " ms" << std::endl;
+                    benchmark_start = glfwGetTime();
+                    benchmark_frames = 0;
+                }
+            }
         }
 
         // Cleanup
-        delete g_root;
+        DestroyScene();
+        delete g_simulation;
+        delete g_job_system;
+        delete g_mesh_registry;
+        delete g_instanced_renderer;
+        delete g_frame_uniforms;
         delete g_game_manager;
         delete g_hud;
         delete g_starfield;
@@ -772,12 +1013,9 @@ int main(void) {
         delete g_enhanced_hud;
 
         // Cleanup shader programs
-        if (g_program != 0) {
-            glDeleteProgram(g_program);
-        }
-        if (g_particle_program != 0) {
-            glDeleteProgram(g_particle_program);
-        }
+        delete g_program;
+        delete g_particle_program;
+        delete g_instanced_program;
 
         glfwTerminate();
     }
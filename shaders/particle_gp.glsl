@@ -8,8 +8,7 @@ layout (triangle_strip, max_vertices = 4) out;
 in vec3 vertex_color[];
 in float timestep[];
 
-// Uniform (global) buffer
-uniform mat4 projection_mat;
+// Projection comes from the FrameData block (frame.projection)
 
 // Simulation parameters (constants)
 uniform float particle_size = 0.01;
@@ -38,7 +37,7 @@ void main(void){
 
     // Create the new geometry: a quad with four vertices from the vector v
     for (int i = 0; i < 4; i++){
-        gl_Position = projection_mat * v[i];
+        gl_Position = frame.projection * v[i];
         frag_color = vec4(vertex_color[0], 1.0);
         EmitVertex();
      }
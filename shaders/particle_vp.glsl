@@ -5,9 +5,8 @@ in vec3 vertex;
 in vec3 normal;
 in vec3 color;
 
-// Uniform (global) buffer
+// Uniform (global) buffer; view matrix comes from the FrameData block
 uniform mat4 world_mat;
-uniform mat4 view_mat;
 uniform mat4 normal_mat;
 uniform float timer;
 
@@ -38,7 +37,7 @@ void main()
     position.z += norm.z*t*speed - grav*speed*up_vec.z*t*t;
     
     // Now apply view transformation
-    gl_Position = view_mat * position;
+    gl_Position = frame.view * position;
         
     // Define outputs
     // Define color of vertex
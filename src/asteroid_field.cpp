@@ -0,0 +1,198 @@
+#include "asteroid_field.h"
+#include "random.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <glm/gtc/constants.hpp>
+
+ChunkFieldSettings::ChunkFieldSettings()
+    : chunk_size(40.0f), load_radius(2), min_asteroids(8), max_asteroids(20), spawn_clearance(12.0f),
+      chunks_per_step(25) {}
+
+// Fold a chunk coordinate into a seed; Random::Seed() mixes the result further
+static uint64_t MixChunkKey(uint64_t key, int value) {
+    key ^= static_cast<uint32_t>(value);
+    key *= 0x9e3779b97f4a7c15ull;
+    return key ^ (key >> 32);
+}
+
+// Chebyshev distance between chunks, so the loaded region is a cube
+static int ChunkDistance(const ChunkCoord& a, const ChunkCoord& b) {
+    return std::max(std::abs(a.x - b.x), std::max(std::abs(a.y - b.y), std::abs(a.z - b.z)));
+}
+
+AsteroidField::AsteroidField()
+    : seed(0), center{0, 0, 0}, has_center(false), chunks_generated(0), next_offset(0), chunk_table_mask(0) {}
+
+size_t AsteroidField::GetBlockCapacity() const {
+    // Everything within the unload radius can still be resident
+    size_t side = static_cast<size_t>(2 * (settings.load_radius + 1) + 1);
+    return side * side * side;
+}
+
+size_t AsteroidField::GetRowCapacity() const {
+    return GetBlockCapacity() * static_cast<size_t>(settings.max_asteroids);
+}
+
+void AsteroidField::Create() {
+    size_t capacity = GetBlockCapacity();
+    block_chunks.assign(capacity, ChunkCoord{0, 0, 0});
+    block_resident.assign(capacity, 0);
+    free_blocks.reserve(capacity);
+    evicted_blocks.reserve(capacity);
+    loaded_blocks.reserve(capacity);
+
+    int radius = settings.load_radius;
+    load_offsets.clear();
+    for (int dz = -radius; dz <= radius; dz++) {
+        for (int dy = -radius; dy <= radius; dy++) {
+            for (int dx = -radius; dx <= radius; dx++) {
+                load_offsets.push_back(ChunkCoord{dx, dy, dz});
+            }
+        }
+    }
+    ChunkCoord origin{0, 0, 0};
+    std::stable_sort(load_offsets.begin(), load_offsets.end(), [&origin](const ChunkCoord& a, const ChunkCoord& b) {
+        return ChunkDistance(a, origin) < ChunkDistance(b, origin);
+    });
+
+    size_t table_size = 1;
+    while (table_size < 2 * capacity) {
+        table_size *= 2;
+    }
+    chunk_table.assign(table_size, -1);
+    chunk_table_mask = table_size - 1;
+    Reset(0);
+}
+
+void AsteroidField::Clear() {
+    block_chunks.clear();
+    block_resident.clear();
+    free_blocks.clear();
+    evicted_blocks.clear();
+    loaded_blocks.clear();
+    load_offsets.clear();
+    chunk_table.clear();
+    chunk_table_mask = 0;
+    has_center = false;
+}
+
+void AsteroidField::Reset(uint64_t field_seed) {
+    seed = field_seed;
+    std::fill(block_resident.begin(), block_resident.end(), 0);
+    free_blocks.clear();
+    for (size_t i = block_resident.size(); i-- > 0;) {
+        free_blocks.push_back(static_cast<int>(i));
+    }
+    evicted_blocks.clear();
+    loaded_blocks.clear();
+    std::fill(chunk_table.begin(), chunk_table.end(), -1);
+    has_center = false;
+    next_offset = 0;
+}
+
+ChunkCoord AsteroidField::GetChunk(const glm::vec3& position) const {
+    return ChunkCoord{static_cast<int>(std::floor(position.x / settings.chunk_size)),
+                      static_cast<int>(std::floor(position.y / settings.chunk_size)),
+                      static_cast<int>(std::floor(position.z / settings.chunk_size))};
+}
+
+// Home entry of chunk in the table
+size_t AsteroidField::GetTableEntry(const ChunkCoord& chunk) const {
+    uint64_t key = MixChunkKey(MixChunkKey(MixChunkKey(0, chunk.x), chunk.y), chunk.z);
+    return static_cast<size_t>(key) & chunk_table_mask;
+}
+
+int AsteroidField::FindBlock(const ChunkCoord& chunk) const {
+    for (size_t entry = GetTableEntry(chunk);; entry = (entry + 1) & chunk_table_mask) {
+        int block = chunk_table[entry];
+        if (block == -1 || block_chunks[block] == chunk) return block;
+    }
+}
+
+void AsteroidField::InsertBlock(int block) {
+    size_t entry = GetTableEntry(block_chunks[block]);
+    while (chunk_table[entry] != -1) {
+        entry = (entry + 1) & chunk_table_mask;
+    }
+    chunk_table[entry] = block;
+}
+
+// Backward-shift deletion: entries after the hole that could live in it move
+// up, so lookups never need tombstones
+void AsteroidField::RemoveBlock(int block) {
+    size_t hole = GetTableEntry(block_chunks[block]);
+    while (chunk_table[hole] != block) {
+        hole = (hole + 1) & chunk_table_mask;
+    }
+    for (size_t entry = (hole + 1) & chunk_table_mask; chunk_table[entry] != -1;
+         entry = (entry + 1) & chunk_table_mask) {
+        size_t home = GetTableEntry(block_chunks[chunk_table[entry]]);
+        // Move the entry unless its home lies cyclically in (hole, entry]
+        if (((entry - home) & chunk_table_mask) >= ((entry - hole) & chunk_table_mask)) {
+            chunk_table[hole] = chunk_table[entry];
+            hole = entry;
+        }
+    }
+    chunk_table[hole] = -1;
+}
+
+void AsteroidField::Update(const glm::vec3& position, int max_loads) {
+    evicted_blocks.clear();
+    loaded_blocks.clear();
+
+    ChunkCoord chunk = GetChunk(position);
+    if (!has_center || chunk != center) {
+        center = chunk;
+        has_center = true;
+        next_offset = 0;
+        for (size_t i = 0; i < block_chunks.size(); i++) {
+            if (block_resident[i] && ChunkDistance(block_chunks[i], center) > settings.load_radius + 1) {
+                RemoveBlock(static_cast<int>(i));
+                block_resident[i] = 0;
+                free_blocks.push_back(static_cast<int>(i));
+                evicted_blocks.push_back(static_cast<int>(i));
+            }
+        }
+    }
+
+    // Every chunk left resident is within the unload radius, so a free block
+    // is always available for the chunks within the load radius
+    while (next_offset < load_offsets.size() && loaded_blocks.size() < static_cast<size_t>(max_loads)) {
+        const ChunkCoord& offset = load_offsets[next_offset++];
+        ChunkCoord wanted{center.x + offset.x, center.y + offset.y, center.z + offset.z};
+        if (FindBlock(wanted) != -1 || free_blocks.empty()) continue;
+        int block = free_blocks.back();
+        free_blocks.pop_back();
+        block_chunks[block] = wanted;
+        block_resident[block] = 1;
+        InsertBlock(block);
+        loaded_blocks.push_back(block);
+    }
+    chunks_generated += loaded_blocks.size();
+}
+
+void AsteroidField::GenerateBlock(int block, AsteroidComponents& asteroids) const {
+    const ChunkCoord& chunk = block_chunks[block];
+    Random random(MixChunkKey(MixChunkKey(MixChunkKey(seed, chunk.x), chunk.y), chunk.z));
+    glm::vec3 origin = glm::vec3(static_cast<float>(chunk.x), static_cast<float>(chunk.y),
+                                 static_cast<float>(chunk.z)) * settings.chunk_size;
+
+    int count = random.NextInt(settings.min_asteroids, settings.max_asteroids);
+    size_t first_row = GetFirstRow(block);
+    for (int i = 0; i < settings.max_asteroids; i++) {
+        size_t row = first_row + i;
+        if (i >= count) {
+            asteroids.live[row] = 0;
+            continue;
+        }
+
+        glm::vec3 offset(random.NextFloat(), random.NextFloat(), random.NextFloat());
+        float yaw = random.NextFloat(0.0f, 2.0f * glm::pi<float>());
+        glm::vec3 position = origin + offset * settings.chunk_size;
+
+        asteroids.positions[row] = position;
+        asteroids.orientations[row] = glm::angleAxis(yaw, glm::vec3(0.0f, 1.0f, 0.0f));
+        asteroids.live[row] = glm::length(position) >= settings.spawn_clearance ? 1 : 0;
+    }
+}
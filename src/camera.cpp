@@ -14,6 +14,10 @@ glm::mat4 Camera::GetViewMatrix() {
     return glm::inverse(world_transform);
 }
 
+glm::mat4 Camera::ComputeViewMatrix() const {
+    return glm::inverse(ComputeWorldTransform());
+}
+
 void Camera::ToggleView() {
     is_first_person = !is_first_person;
     std::cout << "Camera switched to " << (is_first_person ? "FIRST-PERSON" : "THIRD-PERSON") << " view" << std::endl;
@@ -22,15 +26,15 @@ void Camera::ToggleView() {
 void Camera::UpdateCameraPosition(SceneNode* ship) {
     if (is_first_person) {
         // First-person: camera at ship position
-        position = glm::vec3(0.0f, 0.5f, 0.0f); // Slightly above ship center
-        orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f); // Look forward
+        SetPosition(glm::vec3(0.0f, 0.5f, 0.0f)); // Slightly above ship center
+        SetOrientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)); // Look forward
     } else {
         // Third-person: camera behind and above ship
-        position = offset_third_person;
+        SetPosition(offset_third_person);
         // Look at ship from behind
         glm::vec3 look_direction = glm::normalize(-offset_third_person);
         float pitch = asin(look_direction.y);
         glm::quat pitch_rot = glm::angleAxis(pitch, glm::vec3(1.0f, 0.0f, 0.0f));
-        orientation = pitch_rot;
+        SetOrientation(pitch_rot);
     }
 }
@@ -0,0 +1,65 @@
+#include "collision.h"
+#include <cmath>
+
+bool RayIntersectsSphere(const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                         const glm::vec3& center, float radius) {
+    glm::vec3 oc = ray_origin - center;
+    float a = glm::dot(ray_direction, ray_direction);
+    float b = 2.0f * glm::dot(oc, ray_direction);
+    float c = glm::dot(oc, oc) - radius * radius;
+    float discriminant = b * b - 4 * a * c;
+
+    return discriminant >= 0.0f;
+}
+
+bool RaySphereDistance(const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                       const glm::vec3& center, float radius, float max_distance, float& distance) {
+    glm::vec3 m = ray_origin - center;
+    float b = glm::dot(m, ray_direction);
+    float c = glm::dot(m, m) - radius * radius;
+
+    // Origin outside the sphere and pointing away from it
+    if (c > 0.0f && b > 0.0f) return false;
+
+    float discriminant = b * b - c;
+    if (discriminant < 0.0f) return false;
+
+    float t = -b - std::sqrt(discriminant);
+    if (t < 0.0f) t = 0.0f;  // Started inside
+    if (t > max_distance) return false;
+
+    distance = t;
+    return true;
+}
+
+bool SegmentSphereTimeOfImpact(const glm::vec3& start, const glm::vec3& end,
+                               const glm::vec3& center, float radius, float& time_of_impact) {
+    glm::vec3 m = start - center;
+    float c = glm::dot(m, m) - radius * radius;
+    if (c <= 0.0f) {
+        time_of_impact = 0.0f;
+        return true;
+    }
+
+    // Solve |m + t*d|^2 = r^2 for the smaller root, without normalizing d
+    glm::vec3 d = end - start;
+    float a = glm::dot(d, d);
+    float b = glm::dot(m, d);
+    if (a <= 0.0f || b >= 0.0f) return false;  // Not moving, or moving away
+
+    float discriminant = b * b - a * c;
+    if (discriminant < 0.0f) return false;
+
+    float t = (-b - std::sqrt(discriminant)) / a;
+    if (t > 1.0f) return false;  // Reaches the sphere only after this step
+
+    time_of_impact = t;
+    return true;
+}
+
+bool SpheresOverlap(const glm::vec3& center_a, float radius_a,
+                    const glm::vec3& center_b, float radius_b) {
+    glm::vec3 offset = center_a - center_b;
+    float combined_radius = radius_a + radius_b;
+    return glm::dot(offset, offset) < combined_radius * combined_radius;
+}
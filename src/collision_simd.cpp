@@ -0,0 +1,187 @@
+#include "collision_simd.h"
+#include "collision.h"
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+// Defined in collision_simd_avx2.cpp, which is the only file built with AVX2 enabled
+bool IsAvx2KernelCompiled();
+size_t SegmentSphereAvx2(const SphereArrays& spheres, size_t count, const glm::vec3& start, const glm::vec3& end,
+                         uint32_t* hit_mask, float* time_of_impact);
+
+static bool CpuSupportsAvx2() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+
+    // AVX needs the OS to save the YMM registers (OSXSAVE + XCR0 bits 1 and 2)
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) return false;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+bool IsSimdLevelSupported(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return true;
+        case SimdLevel::SSE2:
+#ifdef COLLISION_SIMD_SSE2
+            return true;
+#else
+            return false;
+#endif
+        case SimdLevel::AVX2: {
+            static const bool supported = IsAvx2KernelCompiled() && CpuSupportsAvx2();
+            return supported;
+        }
+    }
+    return false;
+}
+
+SimdLevel GetBestSimdLevel() {
+    if (IsSimdLevelSupported(SimdLevel::AVX2)) return SimdLevel::AVX2;
+    if (IsSimdLevelSupported(SimdLevel::SSE2)) return SimdLevel::SSE2;
+    return SimdLevel::SCALAR;
+}
+
+const char* GetSimdLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2: return "SSE2";
+        case SimdLevel::AVX2: return "AVX2";
+        default: return "SCALAR";
+    }
+}
+
+void SphereArrays::Clear() {
+    center_x.clear();
+    center_y.clear();
+    center_z.clear();
+    radius.clear();
+    user_id.clear();
+}
+
+void SphereArrays::Add(const glm::vec3& center, float sphere_radius, int id) {
+    center_x.push_back(center.x);
+    center_y.push_back(center.y);
+    center_z.push_back(center.z);
+    radius.push_back(sphere_radius);
+    user_id.push_back(id);
+}
+
+// Reference path, also used for the tail that does not fill a SIMD register
+static size_t SegmentSphereScalar(const SphereArrays& spheres, size_t begin, size_t count,
+                                  const glm::vec3& start, const glm::vec3& end,
+                                  uint32_t* hit_mask, float* time_of_impact) {
+    size_t hits = 0;
+    for (size_t i = begin; i < count; i++) {
+        glm::vec3 center(spheres.center_x[i], spheres.center_y[i], spheres.center_z[i]);
+        float t;
+        if (SegmentSphereTimeOfImpact(start, end, center, spheres.radius[i], t)) {
+            time_of_impact[i] = t;
+            hit_mask[i >> 5] |= 1u << (i & 31);
+            hits++;
+        } else {
+            time_of_impact[i] = std::numeric_limits<float>::infinity();
+        }
+    }
+    return hits;
+}
+
+#ifdef COLLISION_SIMD_SSE2
+// Four spheres per iteration; same arithmetic as SegmentSphereTimeOfImpact
+static size_t SegmentSphereSse2(const SphereArrays& spheres, size_t count,
+                                const glm::vec3& start, const glm::vec3& end,
+                                uint32_t* hit_mask, float* time_of_impact) {
+    glm::vec3 direction = end - start;
+    float a = glm::dot(direction, direction);
+
+    const __m128 start_x = _mm_set1_ps(start.x);
+    const __m128 start_y = _mm_set1_ps(start.y);
+    const __m128 start_z = _mm_set1_ps(start.z);
+    const __m128 dir_x = _mm_set1_ps(direction.x);
+    const __m128 dir_y = _mm_set1_ps(direction.y);
+    const __m128 dir_z = _mm_set1_ps(direction.z);
+    const __m128 a4 = _mm_set1_ps(a);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 infinity = _mm_set1_ps(std::numeric_limits<float>::infinity());
+    // Only a moving segment can enter a sphere it starts outside of
+    const __m128 moving = a > 0.0f ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+
+    size_t hits = 0;
+    for (size_t i = 0; i < count; i += 4) {
+        __m128 mx = _mm_sub_ps(start_x, _mm_loadu_ps(&spheres.center_x[i]));
+        __m128 my = _mm_sub_ps(start_y, _mm_loadu_ps(&spheres.center_y[i]));
+        __m128 mz = _mm_sub_ps(start_z, _mm_loadu_ps(&spheres.center_z[i]));
+        __m128 r = _mm_loadu_ps(&spheres.radius[i]);
+
+        __m128 mm = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mx, mx), _mm_mul_ps(my, my)), _mm_mul_ps(mz, mz));
+        __m128 c = _mm_sub_ps(mm, _mm_mul_ps(r, r));
+        __m128 b = _mm_add_ps(_mm_add_ps(_mm_mul_ps(mx, dir_x), _mm_mul_ps(my, dir_y)), _mm_mul_ps(mz, dir_z));
+        __m128 discriminant = _mm_sub_ps(_mm_mul_ps(b, b), _mm_mul_ps(a4, c));
+        __m128 root = _mm_sqrt_ps(_mm_max_ps(discriminant, zero));
+        __m128 t = _mm_div_ps(_mm_sub_ps(_mm_sub_ps(zero, b), root), a4);
+
+        __m128 inside = _mm_cmple_ps(c, zero);
+        __m128 entering = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(b, zero), _mm_cmpge_ps(discriminant, zero)),
+                                     _mm_and_ps(_mm_cmple_ps(t, one), moving));
+        __m128 hit = _mm_or_ps(inside, entering);
+
+        // inside ? 0 : t, then hit ? value : infinity
+        __m128 value = _mm_andnot_ps(inside, t);
+        value = _mm_or_ps(_mm_and_ps(hit, value), _mm_andnot_ps(hit, infinity));
+        _mm_storeu_ps(&time_of_impact[i], value);
+
+        uint32_t bits = static_cast<uint32_t>(_mm_movemask_ps(hit));
+        hit_mask[i >> 5] |= bits << (i & 31);
+        for (; bits != 0; bits &= bits - 1) hits++;
+    }
+    return hits;
+}
+#endif
+
+size_t SegmentSphereBatch(SimdLevel level, const SphereArrays& spheres,
+                          const glm::vec3& start, const glm::vec3& end,
+                          std::vector<uint32_t>& hit_mask, std::vector<float>& time_of_impact) {
+    size_t count = spheres.GetCount();
+    hit_mask.assign((count + 31) / 32, 0u);
+    time_of_impact.resize(count);
+    if (count == 0) return 0;
+
+    if (!IsSimdLevelSupported(level)) {
+        level = GetBestSimdLevel();
+    }
+
+    size_t vector_count = 0;
+    size_t hits = 0;
+    if (level == SimdLevel::AVX2) {
+        vector_count = count & ~static_cast<size_t>(7);
+        hits = SegmentSphereAvx2(spheres, vector_count, start, end, hit_mask.data(), time_of_impact.data());
+    }
+#ifdef COLLISION_SIMD_SSE2
+    else if (level == SimdLevel::SSE2) {
+        vector_count = count & ~static_cast<size_t>(3);
+        hits = SegmentSphereSse2(spheres, vector_count, start, end, hit_mask.data(), time_of_impact.data());
+    }
+#endif
+
+    return hits + SegmentSphereScalar(spheres, vector_count, count, start, end,
+                                      hit_mask.data(), time_of_impact.data());
+}
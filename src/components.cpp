@@ -0,0 +1,30 @@
+#include "components.h"
+
+ShipMotion::ShipMotion()
+    : velocity(0.0f), acceleration(0.0f), max_speed(15.0f), acceleration_rate(8.0f), deceleration_rate(5.0f),
+      moving_forward(false), moving_backward(false), moving_left(false), moving_right(false) {}
+
+void AsteroidComponents::Clear() {
+    positions.clear();
+    orientations.clear();
+    colliders.clear();
+    live.clear();
+    entities.clear();
+    nodes.clear();
+}
+
+ProjectileComponents::ProjectileComponents(float projectile_speed, float projectile_lifetime,
+                                           float projectile_spin_rate, glm::vec3 projectile_scale)
+    : speed(projectile_speed), max_lifetime(projectile_lifetime), spin_rate(projectile_spin_rate),
+      scale(projectile_scale) {}
+
+void ProjectileComponents::Clear() {
+    positions.clear();
+    orientations.clear();
+    velocities.clear();
+    lifetimes.clear();
+    colliders.clear();
+    active.clear();
+    entities.clear();
+    nodes.clear();
+}
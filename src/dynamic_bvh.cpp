@@ -0,0 +1,424 @@
+#include "dynamic_bvh.h"
+#include "collision.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+// Depth-first traversal stack size; AVL balancing keeps the height near
+// 1.44 * log2(proxies), far below this for any realistic field
+static const int MAX_STACK = 256;
+
+static float SurfaceArea(const glm::vec3& box_min, const glm::vec3& box_max) {
+    glm::vec3 d = box_max - box_min;
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+static bool BoxContains(const glm::vec3& outer_min, const glm::vec3& outer_max,
+                        const glm::vec3& inner_min, const glm::vec3& inner_max) {
+    return outer_min.x <= inner_min.x && outer_min.y <= inner_min.y && outer_min.z <= inner_min.z &&
+           inner_max.x <= outer_max.x && inner_max.y <= outer_max.y && inner_max.z <= outer_max.z;
+}
+
+// Slab test; inv_direction components may be infinite for axis-parallel rays
+static bool RayHitsBox(const glm::vec3& origin, const glm::vec3& inv_direction,
+                       const glm::vec3& box_min, const glm::vec3& box_max, float max_distance) {
+    float t_near = 0.0f;
+    float t_far = max_distance;
+    for (int axis = 0; axis < 3; axis++) {
+        float t1 = (box_min[axis] - origin[axis]) * inv_direction[axis];
+        float t2 = (box_max[axis] - origin[axis]) * inv_direction[axis];
+        // NaN (origin on a slab plane of a parallel ray) fails both comparisons and is ignored
+        t_near = std::max(t_near, std::min(t1, t2));
+        t_far = std::min(t_far, std::max(t1, t2));
+    }
+    return t_near <= t_far;
+}
+
+static float BoxDistance(const glm::vec3& point, const glm::vec3& box_min, const glm::vec3& box_max) {
+    glm::vec3 closest = glm::clamp(point, box_min, box_max);
+    return glm::length(point - closest);
+}
+
+DynamicBvh::DynamicBvh(float margin)
+    : root(NULL_NODE), free_list(NULL_NODE), proxy_count(0), margin(margin) {}
+
+void DynamicBvh::Clear() {
+    nodes.clear();
+    root = NULL_NODE;
+    free_list = NULL_NODE;
+    proxy_count = 0;
+}
+
+int DynamicBvh::AllocateNode() {
+    int index;
+    if (free_list != NULL_NODE) {
+        index = free_list;
+        free_list = nodes[index].parent;
+    } else {
+        index = static_cast<int>(nodes.size());
+        nodes.push_back(Node());
+    }
+
+    Node& node = nodes[index];
+    node.parent = NULL_NODE;
+    node.child1 = NULL_NODE;
+    node.child2 = NULL_NODE;
+    node.height = 0;
+    node.user_id = -1;
+    node.radius = 0.0f;
+    return index;
+}
+
+void DynamicBvh::FreeNode(int index) {
+    nodes[index].parent = free_list;
+    nodes[index].height = -1;
+    free_list = index;
+}
+
+int DynamicBvh::CreateProxy(const glm::vec3& center, float radius, int user_id) {
+    int proxy = AllocateNode();
+    Node& leaf = nodes[proxy];
+    leaf.center = center;
+    leaf.radius = radius;
+    leaf.user_id = user_id;
+    leaf.box_min = center - glm::vec3(radius + margin);
+    leaf.box_max = center + glm::vec3(radius + margin);
+
+    InsertLeaf(proxy);
+    proxy_count++;
+    return proxy;
+}
+
+void DynamicBvh::DestroyProxy(int proxy) {
+    RemoveLeaf(proxy);
+    FreeNode(proxy);
+    proxy_count--;
+}
+
+bool DynamicBvh::MoveProxy(int proxy, const glm::vec3& center, float radius) {
+    Node& leaf = nodes[proxy];
+    leaf.center = center;
+    leaf.radius = radius;
+
+    // Still inside the fat box: the tree stays valid as it is
+    glm::vec3 tight_min = center - glm::vec3(radius);
+    glm::vec3 tight_max = center + glm::vec3(radius);
+    if (BoxContains(leaf.box_min, leaf.box_max, tight_min, tight_max)) {
+        return false;
+    }
+
+    RemoveLeaf(proxy);
+    nodes[proxy].box_min = tight_min - glm::vec3(margin);
+    nodes[proxy].box_max = tight_max + glm::vec3(margin);
+    InsertLeaf(proxy);
+    return true;
+}
+
+int DynamicBvh::GetHeight() const {
+    return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+void DynamicBvh::FitToChildren(int index) {
+    Node& node = nodes[index];
+    const Node& child1 = nodes[node.child1];
+    const Node& child2 = nodes[node.child2];
+    node.box_min = glm::min(child1.box_min, child2.box_min);
+    node.box_max = glm::max(child1.box_max, child2.box_max);
+    node.height = 1 + std::max(child1.height, child2.height);
+}
+
+void DynamicBvh::InsertLeaf(int leaf) {
+    if (root == NULL_NODE) {
+        root = leaf;
+        nodes[root].parent = NULL_NODE;
+        return;
+    }
+
+    // Descend towards the sibling that minimizes the surface area cost
+    glm::vec3 leaf_min = nodes[leaf].box_min;
+    glm::vec3 leaf_max = nodes[leaf].box_max;
+    int index = root;
+    while (!nodes[index].IsLeaf()) {
+        const Node& node = nodes[index];
+        float area = SurfaceArea(node.box_min, node.box_max);
+        float combined_area = SurfaceArea(glm::min(node.box_min, leaf_min), glm::max(node.box_max, leaf_max));
+
+        // Cost of making a new parent for this node and the leaf
+        float cost = 2.0f * combined_area;
+        // Minimum cost of pushing the leaf further down
+        float inheritance_cost = 2.0f * (combined_area - area);
+
+        float child_costs[2];
+        int children[2] = {node.child1, node.child2};
+        for (int i = 0; i < 2; i++) {
+            const Node& child = nodes[children[i]];
+            float enlarged = SurfaceArea(glm::min(child.box_min, leaf_min), glm::max(child.box_max, leaf_max));
+            child_costs[i] = (child.IsLeaf() ? enlarged : enlarged - SurfaceArea(child.box_min, child.box_max)) +
+                             inheritance_cost;
+        }
+
+        if (cost < child_costs[0] && cost < child_costs[1]) {
+            break;
+        }
+        index = child_costs[0] < child_costs[1] ? children[0] : children[1];
+    }
+
+    // Create a new parent for the sibling and the leaf
+    int sibling = index;
+    int old_parent = nodes[sibling].parent;
+    int new_parent = AllocateNode();  // May reallocate nodes
+    nodes[new_parent].parent = old_parent;
+    nodes[new_parent].child1 = sibling;
+    nodes[new_parent].child2 = leaf;
+    nodes[sibling].parent = new_parent;
+    nodes[leaf].parent = new_parent;
+    FitToChildren(new_parent);
+
+    if (old_parent != NULL_NODE) {
+        if (nodes[old_parent].child1 == sibling) {
+            nodes[old_parent].child1 = new_parent;
+        } else {
+            nodes[old_parent].child2 = new_parent;
+        }
+    } else {
+        root = new_parent;
+    }
+
+    // Refit and rebalance the ancestors
+    index = nodes[leaf].parent;
+    while (index != NULL_NODE) {
+        index = Balance(index);
+        FitToChildren(index);
+        index = nodes[index].parent;
+    }
+}
+
+void DynamicBvh::RemoveLeaf(int leaf) {
+    if (leaf == root) {
+        root = NULL_NODE;
+        return;
+    }
+
+    int parent = nodes[leaf].parent;
+    int grand_parent = nodes[parent].parent;
+    int sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+    if (grand_parent != NULL_NODE) {
+        // Replace the parent with the sibling
+        if (nodes[grand_parent].child1 == parent) {
+            nodes[grand_parent].child1 = sibling;
+        } else {
+            nodes[grand_parent].child2 = sibling;
+        }
+        nodes[sibling].parent = grand_parent;
+        FreeNode(parent);
+
+        int index = grand_parent;
+        while (index != NULL_NODE) {
+            index = Balance(index);
+            FitToChildren(index);
+            index = nodes[index].parent;
+        }
+    } else {
+        root = sibling;
+        nodes[sibling].parent = NULL_NODE;
+        FreeNode(parent);
+    }
+}
+
+// Rotate the taller grandchild up when the subtree of node a is imbalanced.
+// Returns the index of the node now at a's position.
+int DynamicBvh::Balance(int a_index) {
+    Node& a = nodes[a_index];
+    if (a.IsLeaf() || a.height < 2) {
+        return a_index;
+    }
+
+    int b_index = a.child1;
+    int c_index = a.child2;
+    Node& b = nodes[b_index];
+    Node& c = nodes[c_index];
+    int balance = c.height - b.height;
+
+    if (balance > 1) {
+        // Rotate C up
+        int f_index = c.child1;
+        int g_index = c.child2;
+        Node& f = nodes[f_index];
+        Node& g = nodes[g_index];
+
+        c.child1 = a_index;
+        c.parent = a.parent;
+        a.parent = c_index;
+
+        if (c.parent != NULL_NODE) {
+            if (nodes[c.parent].child1 == a_index) {
+                nodes[c.parent].child1 = c_index;
+            } else {
+                nodes[c.parent].child2 = c_index;
+            }
+        } else {
+            root = c_index;
+        }
+
+        if (f.height > g.height) {
+            c.child2 = f_index;
+            a.child2 = g_index;
+            g.parent = a_index;
+        } else {
+            c.child2 = g_index;
+            a.child2 = f_index;
+            f.parent = a_index;
+        }
+        FitToChildren(a_index);
+        FitToChildren(c_index);
+        return c_index;
+    }
+
+    if (balance < -1) {
+        // Rotate B up
+        int d_index = b.child1;
+        int e_index = b.child2;
+        Node& d = nodes[d_index];
+        Node& e = nodes[e_index];
+
+        b.child1 = a_index;
+        b.parent = a.parent;
+        a.parent = b_index;
+
+        if (b.parent != NULL_NODE) {
+            if (nodes[b.parent].child1 == a_index) {
+                nodes[b.parent].child1 = b_index;
+            } else {
+                nodes[b.parent].child2 = b_index;
+            }
+        } else {
+            root = b_index;
+        }
+
+        if (d.height > e.height) {
+            b.child2 = d_index;
+            a.child1 = e_index;
+            e.parent = a_index;
+        } else {
+            b.child2 = e_index;
+            a.child1 = d_index;
+            d.parent = a_index;
+        }
+        FitToChildren(a_index);
+        FitToChildren(b_index);
+        return b_index;
+    }
+
+    return a_index;
+}
+
+bool DynamicBvh::RayCast(const glm::vec3& origin, const glm::vec3& direction, float max_distance,
+                         BvhHit& hit) const {
+    if (root == NULL_NODE) return false;
+
+    glm::vec3 inv_direction(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    float best = max_distance;
+    bool found = false;
+
+    int stack[MAX_STACK];
+    int count = 0;
+    stack[count++] = root;
+    while (count > 0) {
+        const Node& node = nodes[stack[--count]];
+        // The box test uses the current best distance, so farther subtrees are pruned
+        if (!RayHitsBox(origin, inv_direction, node.box_min, node.box_max, best)) {
+            continue;
+        }
+
+        if (node.IsLeaf()) {
+            float distance;
+            if (RaySphereDistance(origin, direction, node.center, node.radius, best, distance)) {
+                best = distance;
+                hit.user_id = node.user_id;
+                hit.distance = distance;
+                found = true;
+            }
+        } else if (count + 2 <= MAX_STACK) {
+            stack[count++] = node.child1;
+            stack[count++] = node.child2;
+        }
+    }
+    return found;
+}
+
+bool DynamicBvh::SegmentCast(const glm::vec3& start, const glm::vec3& end, BvhHit& hit) const {
+    glm::vec3 offset = end - start;
+    float length = glm::length(offset);
+    if (length <= 0.0f) {
+        // Degenerate segment: report any sphere containing the point
+        std::vector<BvhHit> nearest;
+        QueryNearest(start, 1, nearest);
+        if (!nearest.empty() && nearest[0].distance <= 0.0f) {
+            hit = nearest[0];
+            return true;
+        }
+        return false;
+    }
+    return RayCast(start, offset / length, length, hit);
+}
+
+void DynamicBvh::QuerySphere(const glm::vec3& center, float radius, std::vector<int>& result) const {
+    if (root == NULL_NODE) return;
+
+    int stack[MAX_STACK];
+    int count = 0;
+    stack[count++] = root;
+    while (count > 0) {
+        const Node& node = nodes[stack[--count]];
+        if (BoxDistance(center, node.box_min, node.box_max) > radius) {
+            continue;
+        }
+
+        if (node.IsLeaf()) {
+            if (SpheresOverlap(center, radius, node.center, node.radius)) {
+                result.push_back(node.user_id);
+            }
+        } else if (count + 2 <= MAX_STACK) {
+            stack[count++] = node.child1;
+            stack[count++] = node.child2;
+        }
+    }
+}
+
+// Best-first search: boxes are queued by their distance to the point (a lower
+// bound for everything inside); a leaf is re-queued with its exact sphere
+// distance, and exact entries come out in nearest-first order.
+void DynamicBvh::QueryNearest(const glm::vec3& point, size_t k, std::vector<BvhHit>& result) const {
+    if (root == NULL_NODE || k == 0) return;
+
+    struct Candidate {
+        float distance;
+        int node;
+        bool exact;
+        bool operator>(const Candidate& other) const { return distance > other.distance; }
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<Candidate>> queue;
+    queue.push(Candidate{BoxDistance(point, nodes[root].box_min, nodes[root].box_max), root, false});
+
+    size_t found = 0;
+    while (!queue.empty() && found < k) {
+        Candidate candidate = queue.top();
+        queue.pop();
+        const Node& node = nodes[candidate.node];
+
+        if (candidate.exact) {
+            result.push_back(BvhHit{node.user_id, candidate.distance});
+            found++;
+        } else if (node.IsLeaf()) {
+            float distance = std::max(0.0f, glm::length(point - node.center) - node.radius);
+            queue.push(Candidate{distance, candidate.node, true});
+        } else {
+            const Node& child1 = nodes[node.child1];
+            const Node& child2 = nodes[node.child2];
+            queue.push(Candidate{BoxDistance(point, child1.box_min, child1.box_max), node.child1, false});
+            queue.push(Candidate{BoxDistance(point, child2.box_min, child2.box_max), node.child2, false});
+        }
+    }
+}
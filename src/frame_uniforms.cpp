@@ -0,0 +1,39 @@
+#include "frame_uniforms.h"
+
+// Must match FrameData member for member
+const char* FRAME_DATA_GLSL = "\n\
+layout(std140) uniform FrameData {\n\
+    mat4 view;\n\
+    mat4 projection;\n\
+    mat4 view_projection;\n\
+    mat4 ui_projection;\n\
+    vec4 camera_position;\n\
+    vec4 viewport;\n\
+    float time;\n\
+    float delta_time;\n\
+} frame;\n";
+
+static_assert(sizeof(FrameData) == 4 * 64 + 2 * 16 + 16, "FrameData must follow the std140 layout");
+
+FrameUniforms::FrameUniforms() : ubo(0) {}
+
+FrameUniforms::~FrameUniforms() {
+    if (ubo != 0) {
+        glDeleteBuffers(1, &ubo);
+    }
+}
+
+void FrameUniforms::Initialize() {
+    glGenBuffers(1, &ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_UNIFORM_BINDING, ubo);
+}
+
+void FrameUniforms::Update(const FrameData& data) {
+    glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameData), &data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
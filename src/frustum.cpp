@@ -0,0 +1,60 @@
+#include "frustum.h"
+#include <algorithm>
+#include <cmath>
+
+BoundingSphere BoundingSphere::FromTransform(const glm::mat4& world, float object_radius) {
+    float scale_sq = std::max(glm::dot(glm::vec3(world[0]), glm::vec3(world[0])),
+                              std::max(glm::dot(glm::vec3(world[1]), glm::vec3(world[1])),
+                                       glm::dot(glm::vec3(world[2]), glm::vec3(world[2]))));
+    return BoundingSphere(glm::vec3(world[3]), object_radius * std::sqrt(scale_sq));
+}
+
+BoundingSphere BoundingSphere::Merge(const BoundingSphere& a, const BoundingSphere& b) {
+    if (a.IsEmpty()) return b;
+    if (b.IsEmpty()) return a;
+
+    glm::vec3 offset = b.center - a.center;
+    float distance = glm::length(offset);
+
+    // One sphere already contains the other
+    if (distance + b.radius <= a.radius) return a;
+    if (distance + a.radius <= b.radius) return b;
+
+    float radius = (distance + a.radius + b.radius) * 0.5f;
+    glm::vec3 center = a.center + offset * ((radius - a.radius) / distance);
+    return BoundingSphere(center, radius);
+}
+
+Frustum::Frustum() {
+    for (auto& plane : planes) {
+        plane = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+}
+
+void Frustum::Extract(const glm::mat4& m) {
+    // Rows of the matrix (glm is column-major: m[column][row])
+    glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    planes[0] = row3 + row0;  // left
+    planes[1] = row3 - row0;  // right
+    planes[2] = row3 + row1;  // bottom
+    planes[3] = row3 - row1;  // top
+    planes[4] = row3 + row2;  // near
+    planes[5] = row3 - row2;  // far
+
+    for (auto& plane : planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+}
+
+bool Frustum::Intersects(const BoundingSphere& sphere) const {
+    for (const auto& plane : planes) {
+        if (glm::dot(glm::vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -2,6 +2,9 @@
 #include <GL/glew.h>
 #include <glm/gtc/constants.hpp>
 #include <cmath>
+#include <algorithm>
+#include <cstddef>
+#include <vector>
 
 // Helper function for HSV to RGB conversion
 glm::vec3 HSVtoRGB(float h, float s, float v) {
@@ -18,44 +21,125 @@ glm::vec3 HSVtoRGB(float h, float s, float v) {
     return rgb + glm::vec3(m);
 }
 
-Model* CreateCube(float size, glm::vec3 color) {
+GLuint PackSnorm1010102(const glm::vec3& v) {
+    GLuint packed = 0;
+    for (int i = 0; i < 3; i++) {
+        float c = std::max(-1.0f, std::min(1.0f, v[i]));
+        GLint value = static_cast<GLint>(std::round(c * 511.0f));
+        packed |= (static_cast<GLuint>(value) & 0x3FF) << (10 * i);
+    }
+    return packed;
+}
+
+// Vertex layout of all procedural meshes: float position + packed normal (16 bytes)
+struct PackedVertex {
+    GLfloat position[3];
+    GLuint normal;
+};
+
+// Convert interleaved pos(3) + normal(3) float vertices into the packed format,
+// upload them with 16-bit indices when possible, and record the attribute
+// layout in a vertex array object. Color is not part of the vertex data; it
+// is supplied per draw (or per instance) through the color attribute.
+static Model* CreateIndexedModel(const GLfloat* vertex, size_t vertex_bytes,
+                                 const GLuint* face, GLuint index_count) {
+    const size_t source_stride = 6;
+    const GLsizei stride = sizeof(PackedVertex);
+
+    Model* model = new Model;
+    model->size = index_count;
+    model->use_elements = true;
+
+    // Object-space bounding sphere centered on the model origin, used for culling
+    float max_dist_sq = 0.0f;
+    size_t vertex_count = vertex_bytes / (source_stride * sizeof(GLfloat));
+    std::vector<PackedVertex> packed(vertex_count);
+    for (size_t i = 0; i < vertex_count; i++) {
+        const GLfloat* p = vertex + i * source_stride;
+        max_dist_sq = std::max(max_dist_sq, p[0] * p[0] + p[1] * p[1] + p[2] * p[2]);
+
+        packed[i].position[0] = p[0];
+        packed[i].position[1] = p[1];
+        packed[i].position[2] = p[2];
+        packed[i].normal = PackSnorm1010102(glm::vec3(p[3], p[4], p[5]));
+    }
+    model->bounding_radius = std::sqrt(max_dist_sq);
+
+    glGenVertexArrays(1, &model->vao);
+    glBindVertexArray(model->vao);
+
+    glGenBuffers(1, &model->vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, model->vbo);
+    glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex), packed.data(), GL_STATIC_DRAW);
+
+    // Element buffer binding is stored in the VAO
+    glGenBuffers(1, &model->ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->ebo);
+    size_t index_bytes;
+    if (vertex_count <= 65536) {
+        std::vector<GLushort> short_face(face, face + index_count);
+        index_bytes = short_face.size() * sizeof(GLushort);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_bytes, short_face.data(), GL_STATIC_DRAW);
+        model->index_type = GL_UNSIGNED_SHORT;
+    } else {
+        index_bytes = index_count * sizeof(GLuint);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_bytes, face, GL_STATIC_DRAW);
+        model->index_type = GL_UNSIGNED_INT;
+    }
+    model->buffer_bytes = static_cast<GLuint>(packed.size() * sizeof(PackedVertex) + index_bytes);
+
+    glVertexAttribPointer(VERTEX_ATTRIB_LOCATION, 3, GL_FLOAT, GL_FALSE, stride,
+                          (void*)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(VERTEX_ATTRIB_LOCATION);
+
+    glVertexAttribPointer(NORMAL_ATTRIB_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride,
+                          (void*)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(NORMAL_ATTRIB_LOCATION);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    return model;
+}
+
+Model* CreateCube(float size) {
     float h = size / 2.0f;
     const int vertex_num = 24; // 6 faces * 4 vertices
     const int face_num = 12;   // 6 faces * 2 triangles
-    const int vertex_att = 9;  // pos(3) + normal(3) + color(3)
+    const int vertex_att = 6;  // pos(3) + normal(3)
     const int face_att = 3;
 
     GLfloat vertex[vertex_num * vertex_att] = {
         // Front
-        -h, -h,  h,  0, 0, 1,  color.r, color.g, color.b,
-         h, -h,  h,  0, 0, 1,  color.r, color.g, color.b,
-         h,  h,  h,  0, 0, 1,  color.r, color.g, color.b,
-        -h,  h,  h,  0, 0, 1,  color.r, color.g, color.b,
+        -h, -h,  h,  0, 0, 1,
+         h, -h,  h,  0, 0, 1,
+         h,  h,  h,  0, 0, 1,
+        -h,  h,  h,  0, 0, 1,
         // Back
-         h, -h, -h,  0, 0, -1,  color.r, color.g, color.b,
-        -h, -h, -h,  0, 0, -1,  color.r, color.g, color.b,
-        -h,  h, -h,  0, 0, -1,  color.r, color.g, color.b,
-         h,  h, -h,  0, 0, -1,  color.r, color.g, color.b,
+         h, -h, -h,  0, 0, -1,
+        -h, -h, -h,  0, 0, -1,
+        -h,  h, -h,  0, 0, -1,
+         h,  h, -h,  0, 0, -1,
         // Left
-        -h, -h, -h,  -1, 0, 0,  color.r, color.g, color.b,
-        -h, -h,  h,  -1, 0, 0,  color.r, color.g, color.b,
-        -h,  h,  h,  -1, 0, 0,  color.r, color.g, color.b,
-        -h,  h, -h,  -1, 0, 0,  color.r, color.g, color.b,
+        -h, -h, -h,  -1, 0, 0,
+        -h, -h,  h,  -1, 0, 0,
+        -h,  h,  h,  -1, 0, 0,
+        -h,  h, -h,  -1, 0, 0,
         // Right
-         h, -h,  h,  1, 0, 0,  color.r, color.g, color.b,
-         h, -h, -h,  1, 0, 0,  color.r, color.g, color.b,
-         h,  h, -h,  1, 0, 0,  color.r, color.g, color.b,
-         h,  h,  h,  1, 0, 0,  color.r, color.g, color.b,
+         h, -h,  h,  1, 0, 0,
+         h, -h, -h,  1, 0, 0,
+         h,  h, -h,  1, 0, 0,
+         h,  h,  h,  1, 0, 0,
         // Top
-        -h,  h,  h,  0, 1, 0,  color.r, color.g, color.b,
-         h,  h,  h,  0, 1, 0,  color.r, color.g, color.b,
-         h,  h, -h,  0, 1, 0,  color.r, color.g, color.b,
-        -h,  h, -h,  0, 1, 0,  color.r, color.g, color.b,
+        -h,  h,  h,  0, 1, 0,
+         h,  h,  h,  0, 1, 0,
+         h,  h, -h,  0, 1, 0,
+        -h,  h, -h,  0, 1, 0,
         // Bottom
-        -h, -h, -h,  0, -1, 0,  color.r, color.g, color.b,
-         h, -h, -h,  0, -1, 0,  color.r, color.g, color.b,
-         h, -h,  h,  0, -1, 0,  color.r, color.g, color.b,
-        -h, -h,  h,  0, -1, 0,  color.r, color.g, color.b,
+        -h, -h, -h,  0, -1, 0,
+         h, -h, -h,  0, -1, 0,
+         h, -h,  h,  0, -1, 0,
+        -h, -h,  h,  0, -1, 0,
     };
 
     GLuint face[face_num * face_att] = {
@@ -67,25 +151,13 @@ Model* CreateCube(float size, glm::vec3 color) {
         20,21,22, 22,23,20
     };
 
-    Model* model = new Model;
-    model->size = face_num * face_att;
-    model->use_elements = true;
-
-    glGenBuffers(1, &model->vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, model->vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(vertex), vertex, GL_STATIC_DRAW);
-
-    glGenBuffers(1, &model->ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(face), face, GL_STATIC_DRAW);
-
-    return model;
+    return CreateIndexedModel(vertex, sizeof(vertex), face, face_num * face_att);
 }
 
-Model* CreateSphere(float radius, int latitudes, int longitudes, glm::vec3 color) {
+Model* CreateSphere(float radius, int latitudes, int longitudes) {
     const int vertex_num = (latitudes + 1) * (longitudes + 1);
     const int face_num = latitudes * longitudes * 2;
-    const int vertex_att = 9;
+    const int vertex_att = 6;
     const int face_att = 3;
 
     GLfloat* vertex = new GLfloat[vertex_num * vertex_att];
@@ -113,9 +185,6 @@ Model* CreateSphere(float radius, int latitudes, int longitudes, glm::vec3 color
             vertex[v_idx++] = x / radius;
             vertex[v_idx++] = y / radius;
             vertex[v_idx++] = z / radius;
-            vertex[v_idx++] = color.r;
-            vertex[v_idx++] = color.g;
-            vertex[v_idx++] = color.b;
         }
     }
 
@@ -134,17 +203,8 @@ Model* CreateSphere(float radius, int latitudes, int longitudes, glm::vec3 color
         }
     }
 
-    Model* model = new Model;
-    model->size = face_num * face_att;
-    model->use_elements = true;
-
-    glGenBuffers(1, &model->vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, model->vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertex_num * vertex_att * sizeof(GLfloat), vertex, GL_STATIC_DRAW);
-
-    glGenBuffers(1, &model->ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, face_num * face_att * sizeof(GLuint), face, GL_STATIC_DRAW);
+    Model* model = CreateIndexedModel(vertex, vertex_num * vertex_att * sizeof(GLfloat),
+                                      face, face_num * face_att);
 
     delete[] vertex;
     delete[] face;
@@ -152,10 +212,10 @@ Model* CreateSphere(float radius, int latitudes, int longitudes, glm::vec3 color
     return model;
 }
 
-Model* CreateCylinder(float radius, float height, int segments, glm::vec3 color) {
+Model* CreateCylinder(float radius, float height, int segments) {
     const int vertex_num = segments * 2 + 2; // sides + top/bottom centers
     const int face_num = segments * 4; // sides (2 per segment) + caps (1 per segment each)
-    const int vertex_att = 9;
+    const int vertex_att = 6;
     const int face_att = 3;
 
     GLfloat* vertex = new GLfloat[vertex_num * vertex_att];
@@ -177,9 +237,6 @@ Model* CreateCylinder(float radius, float height, int segments, glm::vec3 color)
         vertex[v_idx++] = cos_a;
         vertex[v_idx++] = 0;
         vertex[v_idx++] = sin_a;
-        vertex[v_idx++] = color.r;
-        vertex[v_idx++] = color.g;
-        vertex[v_idx++] = color.b;
 
         // Top
         vertex[v_idx++] = radius * cos_a;
@@ -188,9 +245,6 @@ Model* CreateCylinder(float radius, float height, int segments, glm::vec3 color)
         vertex[v_idx++] = cos_a;
         vertex[v_idx++] = 0;
         vertex[v_idx++] = sin_a;
-        vertex[v_idx++] = color.r;
-        vertex[v_idx++] = color.g;
-        vertex[v_idx++] = color.b;
     }
 
     // Center vertices for caps
@@ -199,11 +253,9 @@ Model* CreateCylinder(float radius, float height, int segments, glm::vec3 color)
 
     vertex[v_idx++] = 0; vertex[v_idx++] = half_height; vertex[v_idx++] = 0;
     vertex[v_idx++] = 0; vertex[v_idx++] = 1; vertex[v_idx++] = 0;
-    vertex[v_idx++] = color.r; vertex[v_idx++] = color.g; vertex[v_idx++] = color.b;
 
     vertex[v_idx++] = 0; vertex[v_idx++] = -half_height; vertex[v_idx++] = 0;
     vertex[v_idx++] = 0; vertex[v_idx++] = -1; vertex[v_idx++] = 0;
-    vertex[v_idx++] = color.r; vertex[v_idx++] = color.g; vertex[v_idx++] = color.b;
 
     // Side faces
     for (int i = 0; i < segments; i++) {
@@ -222,20 +274,19 @@ Model* CreateCylinder(float radius, float height, int segments, glm::vec3 color)
         face[f_idx++] = bottom_center; face[f_idx++] = next_b; face[f_idx++] = curr_b;
     }
 
-    Model* model = new Model;
-    model->size = face_num * face_att;
-    model->use_elements = true;
-
-    glGenBuffers(1, &model->vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, model->vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertex_num * vertex_att * sizeof(GLfloat), vertex, GL_STATIC_DRAW);
-
-    glGenBuffers(1, &model->ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, face_num * face_att * sizeof(GLuint), face, GL_STATIC_DRAW);
+    Model* model = CreateIndexedModel(vertex, vertex_num * vertex_att * sizeof(GLfloat),
+                                      face, face_num * face_att);
 
     delete[] vertex;
     delete[] face;
 
     return model;
 }
+
+void DeleteModel(Model* model) {
+    if (!model) return;
+    glDeleteVertexArrays(1, &model->vao);
+    glDeleteBuffers(1, &model->vbo);
+    glDeleteBuffers(1, &model->ebo);
+    delete model;
+}
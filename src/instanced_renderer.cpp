@@ -0,0 +1,100 @@
+#include "instanced_renderer.h"
+#include "shader_program.h"
+#include <cstddef>
+
+InstancedRenderer::InstancedRenderer()
+    : instance_vbo(0), instance_capacity(0), draw_calls(0), instance_count(0) {}
+
+InstancedRenderer::~InstancedRenderer() {
+    if (instance_vbo != 0) {
+        glDeleteBuffers(1, &instance_vbo);
+    }
+}
+
+void InstancedRenderer::Initialize() {
+    glGenBuffers(1, &instance_vbo);
+}
+
+void InstancedRenderer::Begin() {
+    // Keep the batches and their storage so steady-state frames do not allocate
+    for (auto& batch : batches) {
+        batch.instances.clear();
+    }
+}
+
+void InstancedRenderer::Submit(const Model* model, const glm::mat4& world, const glm::vec3& color) {
+    Batch* target = nullptr;
+    for (auto& batch : batches) {
+        if (batch.model == model) {
+            target = &batch;
+            break;
+        }
+    }
+    if (!target) {
+        batches.push_back(Batch{model, {}});
+        target = &batches.back();
+    }
+    target->instances.push_back(InstanceData{world, color});
+}
+
+void InstancedRenderer::Flush(const ShaderProgram& program) {
+    draw_calls = 0;
+    instance_count = 0;
+
+    size_t total = 0;
+    for (const auto& batch : batches) {
+        total += batch.instances.size();
+    }
+    if (total == 0) return;
+
+    // Grow the buffer when needed, otherwise orphan it so the driver does not
+    // stall on last frame's instance data
+    glBindBuffer(GL_ARRAY_BUFFER, instance_vbo);
+    if (total > instance_capacity) {
+        instance_capacity = total * 2;
+    }
+    glBufferData(GL_ARRAY_BUFFER, instance_capacity * sizeof(InstanceData), NULL, GL_STREAM_DRAW);
+
+    program.Use();
+
+    const GLsizei stride = sizeof(InstanceData);
+    size_t offset = 0;
+    for (const auto& batch : batches) {
+        GLsizei count = static_cast<GLsizei>(batch.instances.size());
+        if (count == 0) continue;
+
+        size_t base = offset * sizeof(InstanceData);
+        glBufferSubData(GL_ARRAY_BUFFER, base, count * sizeof(InstanceData), batch.instances.data());
+
+        // Point the mesh's VAO at this batch's slice of the instance buffer
+        glBindVertexArray(batch.model->vao);
+
+        glVertexAttribPointer(COLOR_ATTRIB_LOCATION, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)(base + offsetof(InstanceData, color)));
+        glVertexAttribDivisor(COLOR_ATTRIB_LOCATION, 1);
+        glEnableVertexAttribArray(COLOR_ATTRIB_LOCATION);
+
+        for (GLuint column = 0; column < 4; column++) {
+            GLuint location = INSTANCE_WORLD_ATTRIB_LOCATION + column;
+            glVertexAttribPointer(location, 4, GL_FLOAT, GL_FALSE, stride,
+                                  (void*)(base + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(location, 1);
+            glEnableVertexAttribArray(location);
+        }
+
+        glDrawElementsInstanced(GL_TRIANGLES, batch.model->size, batch.model->index_type, 0, count);
+
+        // Non-instanced draws of the same mesh use a constant color again
+        glDisableVertexAttribArray(COLOR_ATTRIB_LOCATION);
+        for (GLuint column = 0; column < 4; column++) {
+            glDisableVertexAttribArray(INSTANCE_WORLD_ATTRIB_LOCATION + column);
+        }
+
+        offset += count;
+        draw_calls++;
+        instance_count += count;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
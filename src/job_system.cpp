@@ -0,0 +1,256 @@
+#include "job_system.h"
+#include <algorithm>
+#include <stdexcept>
+
+// The job system a worker thread belongs to and its index there; null and 0
+// for any other thread
+static thread_local const JobSystem* t_thread_system = nullptr;
+static thread_local unsigned int t_thread_index = 0;
+
+JobGraph::JobGraph() : prepared(false) {}
+
+JobGraph::JobId JobGraph::Add(std::function<void()> function) {
+    Node node;
+    node.function = std::move(function);
+    node.prerequisite_count = 0;
+    nodes.push_back(std::move(node));
+    prepared = false;
+    return static_cast<JobId>(nodes.size() - 1);
+}
+
+void JobGraph::Depend(JobId job, JobId prerequisite) {
+    nodes[prerequisite].successors.push_back(job);
+    nodes[job].prerequisite_count++;
+    prepared = false;
+}
+
+void JobGraph::Clear() {
+    nodes.clear();
+    roots.clear();
+    pending.reset();
+    prepared = false;
+}
+
+// Reject cycles, which would otherwise never finish, and collect the roots
+void JobGraph::Prepare() {
+    size_t node_count = nodes.size();
+    std::vector<int> in_degree(node_count);
+    roots.clear();
+    for (size_t i = 0; i < node_count; i++) {
+        in_degree[i] = nodes[i].prerequisite_count;
+        if (in_degree[i] == 0) {
+            roots.push_back(static_cast<JobId>(i));
+        }
+    }
+    std::vector<JobId> ready = roots;
+    size_t ordered = 0;
+    while (!ready.empty()) {
+        JobId node = ready.back();
+        ready.pop_back();
+        ordered++;
+        for (JobId successor : nodes[node].successors) {
+            if (--in_degree[successor] == 0) {
+                ready.push_back(successor);
+            }
+        }
+    }
+    if (ordered != node_count) {
+        throw(std::runtime_error("Job graph has a dependency cycle"));
+    }
+
+    pending.reset(new std::atomic<int>[node_count]);
+    prepared = true;
+}
+
+// State of one JobSystem::Run() call, shared by the graph's jobs
+struct GraphRun {
+    JobSystem* system;
+    JobGraph* graph;
+    std::atomic<size_t>* remaining;
+};
+
+JobSystem::JobSystem(unsigned int requested_threads)
+    : thread_count(requested_threads), queued_jobs(0), stopping(false), jobs_run(0), jobs_stolen(0) {
+    if (thread_count == 0) {
+        thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for (unsigned int i = 0; i < thread_count; i++) {
+        queues.push_back(std::unique_ptr<WorkQueue>(new WorkQueue()));
+    }
+    for (unsigned int i = 1; i < thread_count; i++) {
+        workers.emplace_back(&JobSystem::WorkerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+unsigned int JobSystem::GetThreadIndex() const {
+    return t_thread_system == this ? t_thread_index : 0;
+}
+
+void JobSystem::WorkerLoop(unsigned int index) {
+    t_thread_system = this;
+    t_thread_index = index;
+    while (true) {
+        if (TryRunJob(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this]() { return stopping || queued_jobs.load() > 0; });
+        if (stopping) {
+            return;
+        }
+    }
+}
+
+void JobSystem::Push(const Job& job) {
+    unsigned int index = GetThreadIndex();
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(job);
+    }
+    queued_jobs.fetch_add(1);
+    if (!workers.empty()) {
+        // Taking the lock orders this push before any worker's sleep check
+        { std::lock_guard<std::mutex> lock(sleep_mutex); }
+        wake.notify_one();
+    }
+}
+
+// Run one job: the newest from this thread's own queue, otherwise the oldest
+// from the first other queue that has work
+bool JobSystem::TryRunJob(unsigned int index) {
+    Job job;
+    bool found = false;
+    bool stolen = false;
+    {
+        WorkQueue& own = *queues[index];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+    for (unsigned int i = 1; !found && i < thread_count; i++) {
+        WorkQueue& victim = *queues[(index + i) % thread_count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+            found = true;
+            stolen = true;
+        }
+    }
+    if (!found) {
+        return false;
+    }
+
+    queued_jobs.fetch_sub(1);
+    job.function(job.data, job.begin, job.end);
+    jobs_run.fetch_add(1, std::memory_order_relaxed);
+    if (stolen) {
+        jobs_stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    job.remaining->fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+// Help with queued work until remaining drops to zero
+void JobSystem::WaitFor(std::atomic<size_t>& remaining) {
+    unsigned int index = GetThreadIndex();
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        if (!TryRunJob(index)) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+static void RunRange(void* data, size_t begin, size_t end) {
+    (*static_cast<const std::function<void(size_t, size_t)>*>(data))(begin, end);
+}
+
+void JobSystem::ParallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) {
+        return;
+    }
+    grain = std::max<size_t>(grain, 1);
+    size_t chunks = (count + grain - 1) / grain;
+    if (chunks == 1 || thread_count == 1) {
+        for (size_t begin = 0; begin < count; begin += grain) {
+            body(begin, std::min(begin + grain, count));
+        }
+        return;
+    }
+
+    // Pushed last chunk first: this thread pops from the back and starts at
+    // chunk 0, while thieves take the far end of the range
+    std::atomic<size_t> remaining(chunks);
+    for (size_t chunk = chunks; chunk-- > 0;) {
+        Job job;
+        job.function = RunRange;
+        job.data = const_cast<std::function<void(size_t, size_t)>*>(&body);
+        job.begin = chunk * grain;
+        job.end = std::min(job.begin + grain, count);
+        job.remaining = &remaining;
+        Push(job);
+    }
+    WaitFor(remaining);
+}
+
+void JobSystem::RunGraphNode(void* data, size_t node, size_t) {
+    GraphRun& run = *static_cast<GraphRun*>(data);
+    JobGraph::Node& graph_node = run.graph->nodes[node];
+    graph_node.function();
+
+    for (JobGraph::JobId successor : graph_node.successors) {
+        if (run.graph->pending[successor].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            Job job;
+            job.function = RunGraphNode;
+            job.data = &run;
+            job.begin = static_cast<size_t>(successor);
+            job.end = 0;
+            job.remaining = run.remaining;
+            run.system->Push(job);
+        }
+    }
+}
+
+void JobSystem::Run(JobGraph& graph) {
+    size_t node_count = graph.nodes.size();
+    if (node_count == 0) {
+        return;
+    }
+    if (!graph.prepared) {
+        graph.Prepare();
+    }
+
+    std::atomic<size_t> remaining(node_count);
+    GraphRun run;
+    run.system = this;
+    run.graph = &graph;
+    run.remaining = &remaining;
+    for (size_t i = 0; i < node_count; i++) {
+        graph.pending[i].store(graph.nodes[i].prerequisite_count, std::memory_order_relaxed);
+    }
+
+    for (JobGraph::JobId root : graph.roots) {
+        Job job;
+        job.function = RunGraphNode;
+        job.data = &run;
+        job.begin = static_cast<size_t>(root);
+        job.end = 0;
+        job.remaining = &remaining;
+        Push(job);
+    }
+    WaitFor(remaining);
+}
@@ -0,0 +1,201 @@
+#include "linear_scene.h"
+#include "scene_node.h"
+
+LinearScene::LinearScene() : root(nullptr), topology_version(0), simd_level(GetBestSimdLevel()), culled_count(0) {}
+
+void LinearScene::Build(SceneNode* root_node) {
+    root = root_node;
+    topology_version = SceneNode::GetTopologyVersion();
+
+    nodes.clear();
+    parent_indices.clear();
+    if (root) {
+        Flatten(root, -1);
+    }
+
+    // Nodes still attached from the last build saved their interpolation
+    // state only into their old rows; take it back before the rows move
+    size_t count = nodes.size();
+    for (size_t i = 0; i < count; i++) {
+        SceneNode* node = nodes[i];
+        if (node->scene == this) {
+            node->previous_position = previous_positions[node->scene_row];
+            node->previous_orientation = previous_orientations[node->scene_row];
+            node->lod_level = lod_levels[node->scene_row];
+        }
+    }
+
+    positions.resize(count);
+    orientations.resize(count);
+    scales.resize(count);
+    previous_positions.resize(count);
+    previous_orientations.resize(count);
+    local_changed.assign(count, 1);
+    node_visible.resize(count);
+    models.resize(count);
+    bounding_radii.resize(count);
+    colors.resize(count);
+    instanced.resize(count);
+    lods.resize(count);
+    lod_levels.resize(count);
+    draw_positions.resize(count);
+    draw_orientations.resize(count);
+    interpolated.assign(count, 0);
+    local_transforms.resize(count);
+    world_transforms.resize(count);
+    world_changed.assign(count, 1);
+    visibility.resize(count);
+    world_bounds.resize(count);
+    subtree_bounds.resize(count);
+    inside.resize(count);
+    draw_list.reserve(count);
+
+    // The only pass that reads the nodes; the first update rebuilds every matrix
+    for (size_t i = 0; i < count; i++) {
+        SceneNode* node = nodes[i];
+        positions[i] = node->position;
+        orientations[i] = node->orientation;
+        scales[i] = node->scale;
+        previous_positions[i] = node->previous_position;
+        previous_orientations[i] = node->previous_orientation;
+        node_visible[i] = node->visible ? 1 : 0;
+        models[i] = node->model;
+        bounding_radii[i] = node->model ? node->model->bounding_radius : 0.0f;
+        colors[i] = node->color;
+        instanced[i] = node->instanced ? 1 : 0;
+        lods[i] = node->lod;
+        lod_levels[i] = node->lod_level;
+        node->scene = this;
+        node->scene_row = static_cast<int>(i);
+    }
+}
+
+// Depth-first pre-order walk guarantees parents precede their children
+void LinearScene::Flatten(SceneNode* node, int parent_index) {
+    int index = static_cast<int>(nodes.size());
+    nodes.push_back(node);
+    parent_indices.push_back(parent_index);
+
+    for (auto child : node->children) {
+        Flatten(child, index);
+    }
+}
+
+bool LinearScene::NeedsRebuild(SceneNode* root_node) const {
+    return root_node != root || SceneNode::GetTopologyVersion() != topology_version;
+}
+
+void LinearScene::Clear() {
+    for (size_t i = 0; i < nodes.size(); i++) {
+        SceneNode* node = nodes[i];
+        if (node->scene != this) continue;
+        node->previous_position = previous_positions[i];
+        node->previous_orientation = previous_orientations[i];
+        node->lod_level = lod_levels[i];
+        node->scene = nullptr;
+        node->scene_row = -1;
+        node->MarkDirty();
+    }
+    root = nullptr;
+    topology_version = 0;
+    nodes.clear();
+    parent_indices.clear();
+    draw_list.clear();
+    culled_count = 0;
+}
+
+void LinearScene::SaveSimulationState() {
+    previous_positions = positions;
+    previous_orientations = orientations;
+}
+
+void LinearScene::UpdateTransforms(float alpha) {
+    size_t count = parent_indices.size();
+
+    // A row between two poses is rebuilt every frame, and once more when it
+    // comes to rest so it ends exactly on its simulated pose
+    for (size_t i = 0; i < count; i++) {
+        bool moved_position = previous_positions[i] != positions[i];
+        bool moved_orientation = previous_orientations[i] != orientations[i];
+        bool moving = moved_position || moved_orientation;
+        if (!moving && !interpolated[i] && !local_changed[i]) continue;
+
+        draw_positions[i] = moved_position ? glm::mix(previous_positions[i], positions[i], alpha) : positions[i];
+        draw_orientations[i] = moved_orientation ? glm::slerp(previous_orientations[i], orientations[i], alpha)
+                                                 : orientations[i];
+        interpolated[i] = moving ? 1 : 0;
+        local_changed[i] = 1;
+    }
+
+    // Rebuild the changed local matrices a run of consecutive rows at a time
+    for (size_t begin = 0; begin < count;) {
+        if (!local_changed[begin]) {
+            begin++;
+            continue;
+        }
+        size_t end = begin + 1;
+        while (end < count && local_changed[end]) {
+            end++;
+        }
+        ComposeTrsBatch(simd_level, &draw_positions[begin], &draw_orientations[begin], &scales[begin],
+                        &local_transforms[begin], end - begin);
+        SceneNode::transforms_rebuilt += static_cast<unsigned int>(end - begin);
+        begin = end;
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        int parent = parent_indices[i];
+        bool changed = local_changed[i] || (parent >= 0 && world_changed[parent]);
+        if (changed) {
+            world_transforms[i] = parent >= 0 ? world_transforms[parent] * local_transforms[i]
+                                              : local_transforms[i];
+            SceneNode::transforms_rebuilt++;
+        }
+        world_changed[i] = changed ? 1 : 0;
+        local_changed[i] = 0;
+    }
+}
+
+void LinearScene::BuildDrawList(const Frustum* frustum) {
+    size_t count = parent_indices.size();
+    draw_list.clear();
+    culled_count = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        int parent = parent_indices[i];
+        visibility[i] = (node_visible[i] && (parent < 0 || visibility[parent])) ? 1 : 0;
+    }
+
+    if (frustum) {
+        // Children follow their parents, so a reverse pass sees every child
+        // subtree before the parent it merges into
+        for (size_t i = 0; i < count; i++) {
+            world_bounds[i] = models[i] ? BoundingSphere::FromTransform(world_transforms[i], bounding_radii[i])
+                                        : BoundingSphere();
+            subtree_bounds[i] = world_bounds[i];
+        }
+        // Hidden subtrees are left out, as in SceneNode::UpdateBounds()
+        for (size_t i = count; i-- > 0;) {
+            int parent = parent_indices[i];
+            if (parent >= 0 && visibility[i]) {
+                subtree_bounds[parent] = BoundingSphere::Merge(subtree_bounds[parent], subtree_bounds[i]);
+            }
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            int parent = parent_indices[i];
+            inside[i] = ((parent < 0 || inside[parent]) && !subtree_bounds[i].IsEmpty() &&
+                         frustum->Intersects(subtree_bounds[i])) ? 1 : 0;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (!visibility[i] || !models[i]) continue;
+
+        if (frustum && (!inside[i] || !frustum->Intersects(world_bounds[i]))) {
+            culled_count++;
+            continue;
+        }
+        draw_list.push_back(static_cast<int>(i));
+    }
+}
@@ -0,0 +1,15 @@
+#include "linear_scene.h"
+#include "scene_node.h"
+#include "render_context.h"
+
+// LinearScene drawing. Kept apart from linear_scene.cpp so nodes can push
+// their state into a scene in builds without OpenGL.
+
+void LinearScene::Draw(RenderContext& context) {
+    context.nodes_culled += static_cast<unsigned int>(culled_count);
+    for (int index : draw_list) {
+        const Model* model = SceneNode::SelectLodModel(context, models[index], lods[index], world_transforms[index],
+                                                       lod_levels[index]);
+        SceneNode::SubmitModel(context, model, world_transforms[index], colors[index], instanced[index] != 0);
+    }
+}
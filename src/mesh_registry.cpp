@@ -0,0 +1,170 @@
+#include "mesh_registry.h"
+#include "geometry.h"
+#include "scene_node.h"
+#include <algorithm>
+#include <tuple>
+
+bool MeshKey::operator<(const MeshKey& other) const {
+    return std::tie(shape, size_a, size_b, segments_a, segments_b) <
+           std::tie(other.shape, other.size_a, other.size_b, other.segments_a, other.segments_b);
+}
+
+MeshRegistry::MeshRegistry() {}
+
+int LodChain::Select(float screen_radius, int current) const {
+    int last = static_cast<int>(levels.size()) - 1;
+    int level = std::max(0, std::min(current, last));
+
+    // Refine while clearly above the switch point of the next finer level
+    while (level > 0 && screen_radius > switch_radius[level - 1] * (1.0f + LOD_HYSTERESIS)) {
+        level--;
+    }
+    // Coarsen while clearly below this level's own switch point
+    while (level < last && screen_radius < switch_radius[level] * (1.0f - LOD_HYSTERESIS)) {
+        level++;
+    }
+    return level;
+}
+
+MeshRegistry::~MeshRegistry() {
+    for (auto& chain : chains) {
+        delete chain.second.chain;
+    }
+    for (auto& mesh : meshes) {
+        DeleteModel(mesh.second.model);
+    }
+}
+
+Model* MeshRegistry::Acquire(const MeshKey& key) {
+    auto it = meshes.find(key);
+    if (it != meshes.end()) {
+        it->second.ref_count++;
+        return it->second.model;
+    }
+
+    Model* model = nullptr;
+    switch (key.shape) {
+        case MeshShape::CUBE:
+            model = CreateCube(key.size_a);
+            break;
+        case MeshShape::SPHERE:
+            model = CreateSphere(key.size_a, key.segments_a, key.segments_b);
+            break;
+        case MeshShape::CYLINDER:
+            model = CreateCylinder(key.size_a, key.size_b, key.segments_a);
+            break;
+    }
+
+    meshes[key] = Entry{model, 1};
+    keys[model] = key;
+    return model;
+}
+
+Model* MeshRegistry::AcquireCube(float size) {
+    return Acquire(MeshKey{MeshShape::CUBE, size, 0.0f, 0, 0});
+}
+
+Model* MeshRegistry::AcquireSphere(float radius, int latitudes, int longitudes) {
+    return Acquire(MeshKey{MeshShape::SPHERE, radius, 0.0f, latitudes, longitudes});
+}
+
+Model* MeshRegistry::AcquireCylinder(float radius, float height, int segments) {
+    return Acquire(MeshKey{MeshShape::CYLINDER, radius, height, segments, 0});
+}
+
+// Levels use segments * 2 / (level + 2): full, 2/3, 1/2 and 2/5 of the base
+// tessellation, clamped to a minimum that still reads as the same shape.
+LodChain* MeshRegistry::AcquireLod(const MeshKey& key) {
+    auto it = chains.find(key);
+    if (it != chains.end()) {
+        it->second.ref_count++;
+        return it->second.chain;
+    }
+
+    const int level_count = 4;
+    int min_a = std::min(key.segments_a, key.shape == MeshShape::SPHERE ? 4 : 6);
+    int min_b = std::min(key.segments_b, 8);
+
+    LodChain* chain = new LodChain;
+    MeshKey previous = key;
+    for (int level = 0; level < level_count; level++) {
+        MeshKey level_key = key;
+        level_key.segments_a = std::max(min_a, key.segments_a * 2 / (level + 2));
+        if (key.segments_b > 0) {
+            level_key.segments_b = std::max(min_b, key.segments_b * 2 / (level + 2));
+        }
+        // Stop once the tessellation no longer gets coarser
+        if (level > 0 && level_key.segments_a == previous.segments_a &&
+            level_key.segments_b == previous.segments_b) {
+            break;
+        }
+        previous = level_key;
+        if (!chain->levels.empty()) {
+            chain->switch_radius.push_back(LOD_FULL_DETAIL_RADIUS / static_cast<float>(1 << (chain->levels.size() - 1)));
+        }
+        chain->levels.push_back(Acquire(level_key));
+    }
+    chain->switch_radius.push_back(0.0f);  // The coarsest level is used all the way down
+
+    chains[key] = ChainEntry{chain, 1};
+    chain_keys[chain] = key;
+    return chain;
+}
+
+LodChain* MeshRegistry::AcquireSphereLod(float radius, int latitudes, int longitudes) {
+    return AcquireLod(MeshKey{MeshShape::SPHERE, radius, 0.0f, latitudes, longitudes});
+}
+
+LodChain* MeshRegistry::AcquireCylinderLod(float radius, float height, int segments) {
+    return AcquireLod(MeshKey{MeshShape::CYLINDER, radius, height, segments, 0});
+}
+
+void MeshRegistry::ReleaseLod(LodChain* chain) {
+    auto key_it = chain_keys.find(chain);
+    if (key_it == chain_keys.end()) return;
+
+    auto it = chains.find(key_it->second);
+    if (--it->second.ref_count > 0) return;
+
+    for (auto level : chain->levels) {
+        Release(level);
+    }
+    delete chain;
+    chains.erase(it);
+    chain_keys.erase(key_it);
+}
+
+size_t MeshRegistry::GetBufferBytes() const {
+    size_t bytes = 0;
+    for (const auto& mesh : meshes) {
+        bytes += mesh.second.model->buffer_bytes;
+    }
+    return bytes;
+}
+
+void MeshRegistry::Release(Model* model) {
+    auto key_it = keys.find(model);
+    if (key_it == keys.end()) return;  // Not owned by this registry
+
+    auto it = meshes.find(key_it->second);
+    if (--it->second.ref_count > 0) return;
+
+    DeleteModel(model);
+    meshes.erase(it);
+    keys.erase(key_it);
+}
+
+void MeshRegistry::ReleaseTree(SceneNode* node) {
+    if (node->GetLod()) {
+        // The node's model is the chain's finest level, owned by the chain
+        ReleaseLod(node->GetLod());
+        node->SetLod(nullptr);
+        node->SetModel(nullptr);
+    } else if (node->GetModel()) {
+        Release(node->GetModel());
+        node->SetModel(nullptr);
+    }
+    for (auto child : node->children) {
+        ReleaseTree(child);
+    }
+}
@@ -1,24 +1,23 @@
 #include "particle_system.h"
-#include <cstdlib>
-#include <ctime>
+#include "shader_program.h"
+#include "geometry.h"
+#include <cstddef>
+#include <vector>
 #include <cmath>
 #include <iostream>
 #include <GLFW/glfw3.h>
 #include <glm/gtc/matrix_transform.hpp>
 
 // Constructor
-ParticleSystem::ParticleSystem(int num_particles, int max_explosions)
-    : num_particles(num_particles), max_explosions(max_explosions),
-      vao(0), vbo(0), shader_program(0) {
+ParticleSystem::ParticleSystem(uint64_t run_seed, int num_particles, int max_explosions)
+    : num_particles(num_particles), random(run_seed, RandomStream::PARTICLES), max_explosions(max_explosions),
+      vao(0), vbo(0), shader_program(nullptr) {
 
     // Initialize explosion pool
     explosions.resize(max_explosions);
     for (auto& explosion : explosions) {
         explosion.active = false;
     }
-
-    // Seed random number generator
-    srand(static_cast<unsigned int>(time(nullptr)) + 54321);
 }
 
 // Destructor
@@ -27,7 +26,7 @@ ParticleSystem::~ParticleSystem() {
 }
 
 // Initialize OpenGL resources
-void ParticleSystem::Initialize(GLuint particle_shader_program) {
+void ParticleSystem::Initialize(const ShaderProgram* particle_shader_program) {
     this->shader_program = particle_shader_program;
 
     // Create particle geometry
@@ -43,11 +42,13 @@ void ParticleSystem::CreateSphereParticles() {
     // This is similar to drawing a sphere: we will sample points on a sphere,
     // but will allow them to also deviate a bit from the sphere along the normal
 
-    // Number of attributes per particle: position (3), normal (3), color (3)
-    const int particle_att = 9;
-
-    // Allocate memory for particle data
-    GLfloat* particle_data = new GLfloat[num_particles * particle_att];
+    // Per-particle vertex: float position + spray direction packed as 10:10:10:2.
+    // The particle shader colors explosions with a uniform, so no color is stored.
+    struct ParticleVertex {
+        GLfloat position[3];
+        GLuint normal;
+    };
+    std::vector<ParticleVertex> particle_data(num_particles);
 
     float trad = 0.2f;      // Starting point of particles along normal
     float maxspray = 0.5f;  // How much particles deviate from sphere
@@ -55,9 +56,9 @@ void ParticleSystem::CreateSphereParticles() {
 
     for (int i = 0; i < num_particles; i++) {
         // Get three random numbers
-        u = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-        v = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
-        w = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+        u = random.NextFloat();
+        v = random.NextFloat();
+        w = random.NextFloat();
 
         // Use u to define angle theta along one direction of sphere
         theta = u * 2.0f * 3.14159265359f;
@@ -81,25 +82,11 @@ void ParticleSystem::CreateSphereParticles() {
             normal.z * trad
         );
 
-        // Color gradient (for debug/variety)
-        glm::vec3 color(
-            i / static_cast<float>(num_particles),
-            0.0f,
-            1.0f - i / static_cast<float>(num_particles)
-        );
-
-        // Add vectors to data buffer
-        particle_data[i * particle_att + 0] = position.x;
-        particle_data[i * particle_att + 1] = position.y;
-        particle_data[i * particle_att + 2] = position.z;
-
-        particle_data[i * particle_att + 3] = normal.x;
-        particle_data[i * particle_att + 4] = normal.y;
-        particle_data[i * particle_att + 5] = normal.z;
-
-        particle_data[i * particle_att + 6] = color.r;
-        particle_data[i * particle_att + 7] = color.g;
-        particle_data[i * particle_att + 8] = color.b;
+        // Add vectors to data buffer (spray length is at most maxspray, within [-1, 1])
+        particle_data[i].position[0] = position.x;
+        particle_data[i].position[1] = position.y;
+        particle_data[i].position[2] = position.z;
+        particle_data[i].normal = PackSnorm1010102(normal);
     }
 
     // Create VAO
@@ -110,35 +97,26 @@ void ParticleSystem::CreateSphereParticles() {
     glGenBuffers(1, &vbo);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
     glBufferData(GL_ARRAY_BUFFER,
-                 num_particles * particle_att * sizeof(GLfloat),
-                 particle_data,
+                 particle_data.size() * sizeof(ParticleVertex),
+                 particle_data.data(),
                  GL_STATIC_DRAW);
 
     // Set up vertex attributes
     // Position attribute (location 0)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-                         particle_att * sizeof(GLfloat),
-                         (void*)0);
+    glEnableVertexAttribArray(VERTEX_ATTRIB_LOCATION);
+    glVertexAttribPointer(VERTEX_ATTRIB_LOCATION, 3, GL_FLOAT, GL_FALSE,
+                         sizeof(ParticleVertex),
+                         (void*)offsetof(ParticleVertex, position));
 
     // Normal attribute (location 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE,
-                         particle_att * sizeof(GLfloat),
-                         (void*)(3 * sizeof(GLfloat)));
-
-    // Color attribute (location 2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE,
-                         particle_att * sizeof(GLfloat),
-                         (void*)(6 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(NORMAL_ATTRIB_LOCATION);
+    glVertexAttribPointer(NORMAL_ATTRIB_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE,
+                         sizeof(ParticleVertex),
+                         (void*)offsetof(ParticleVertex, normal));
 
     // Unbind
     glBindVertexArray(0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-
-    // Free CPU memory
-    delete[] particle_data;
 }
 
 // Get an inactive explosion slot
@@ -179,15 +157,21 @@ void ParticleSystem::Update(float current_time) {
     }
 }
 
+void ParticleSystem::Clear() {
+    for (auto& explosion : explosions) {
+        explosion.active = false;
+    }
+}
+
 // Render all active explosions
-void ParticleSystem::Render(float current_time, const glm::mat4& view_mat, const glm::mat4& projection_mat) {
-    if (shader_program == 0) {
+void ParticleSystem::Render(float current_time) {
+    if (!shader_program) {
         std::cout << "Warning: Particle shader not initialized!" << std::endl;
         return;
     }
 
     // Use particle shader
-    glUseProgram(shader_program);
+    shader_program->Use();
 
     // Bind particle VAO
     glBindVertexArray(vao);
@@ -199,16 +183,10 @@ void ParticleSystem::Render(float current_time, const glm::mat4& view_mat, const
     // Disable depth writing (but keep depth testing) so particles blend properly
     glDepthMask(GL_FALSE);
 
-    // Set view and projection matrices (same for all explosions)
-    GLint view_mat_loc = glGetUniformLocation(shader_program, "view_mat");
-    GLint proj_mat_loc = glGetUniformLocation(shader_program, "projection_mat");
-
-    if (view_mat_loc != -1) {
-        glUniformMatrix4fv(view_mat_loc, 1, GL_FALSE, &view_mat[0][0]);
-    }
-    if (proj_mat_loc != -1) {
-        glUniformMatrix4fv(proj_mat_loc, 1, GL_FALSE, &projection_mat[0][0]);
-    }
+    GLint world_mat_loc = shader_program->GetUniform(UniformSlot::WORLD_MAT);
+    GLint timer_loc = shader_program->GetUniform(UniformSlot::TIMER);
+    GLint normal_mat_loc = shader_program->GetUniform(UniformSlot::NORMAL_MAT);
+    GLint color_loc = shader_program->GetUniform(UniformSlot::OBJECT_COLOR);
 
     // Render each active explosion
     for (const auto& explosion : explosions) {
@@ -221,11 +199,6 @@ void ParticleSystem::Render(float current_time, const glm::mat4& view_mat, const
         glm::mat4 world_mat = glm::translate(glm::mat4(1.0f), explosion.position);
 
         // Set uniforms for this explosion
-        GLint world_mat_loc = glGetUniformLocation(shader_program, "world_mat");
-        GLint timer_loc = glGetUniformLocation(shader_program, "timer");
-        GLint normal_mat_loc = glGetUniformLocation(shader_program, "normal_mat");
-        GLint color_loc = glGetUniformLocation(shader_program, "object_color");
-
         if (world_mat_loc != -1) {
             glUniformMatrix4fv(world_mat_loc, 1, GL_FALSE, &world_mat[0][0]);
         }
@@ -235,8 +208,8 @@ void ParticleSystem::Render(float current_time, const glm::mat4& view_mat, const
         }
 
         if (normal_mat_loc != -1) {
-            // Normal matrix is transpose of inverse of world matrix
-            glm::mat4 normal_mat = glm::transpose(glm::inverse(world_mat));
+            // The world matrix is a pure translation, which leaves normals unchanged
+            glm::mat4 normal_mat(1.0f);
             glUniformMatrix4fv(normal_mat_loc, 1, GL_FALSE, &normal_mat[0][0]);
         }
 
@@ -0,0 +1,60 @@
+#include "random.h"
+#include <cerrno>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+// SplitMix64 step, used to expand a 64-bit seed into generator state.
+// Consecutive outputs are well mixed even for seeds like 0, 1, 2.
+static uint64_t SplitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+Random::Random(uint64_t seed) {
+    Seed(seed);
+}
+
+Random::Random(uint64_t run_seed, RandomStream stream) {
+    // Offset the run seed by a per-stream multiple of an odd constant; Seed()
+    // mixes the result, so neighbouring streams share no state
+    uint64_t stream_key = static_cast<uint64_t>(stream) + 1;
+    Seed(run_seed ^ (stream_key * 0xd1b54a32d192ed03ull));
+}
+
+void Random::Seed(uint64_t seed) {
+    uint64_t x = seed;
+    uint64_t a = SplitMix64(x);
+    uint64_t b = SplitMix64(x);
+    state[0] = static_cast<uint32_t>(a);
+    state[1] = static_cast<uint32_t>(a >> 32);
+    state[2] = static_cast<uint32_t>(b);
+    state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+float Random::NextFloat() {
+    // Top 24 bits fill the float mantissa exactly
+    return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f);
+}
+
+float Random::NextFloat(float min, float max) {
+    return min + (max - min) * NextFloat();
+}
+
+int Random::NextInt(int min, int max) {
+    // Multiply-shift range reduction (Lemire); the bias is below 2^-32 per value
+    uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+    return static_cast<int>(min + static_cast<int64_t>((NextUInt() * range) >> 32));
+}
+
+uint64_t ParseSeed(const char* text) {
+    errno = 0;
+    char* end = nullptr;
+    unsigned long long value = std::strtoull(text, &end, 0);
+    if (end == text || *end != '\0' || errno == ERANGE || text[0] == '-') {
+        throw(std::runtime_error(std::string("Invalid seed: ") + text));
+    }
+    return static_cast<uint64_t>(value);
+}
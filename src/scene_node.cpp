@@ -1,82 +1,204 @@
 #include "scene_node.h"
-#include <glm/gtc/matrix_transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-#include <glm/gtc/matrix_inverse.hpp>
+#include "linear_scene.h"
+#include "transform_simd.h"
+
+unsigned int SceneNode::transforms_rebuilt = 0;
+unsigned int SceneNode::topology_version = 0;
 
 SceneNode::SceneNode(std::string node_name)
-    : name(node_name), position(0.0f), orientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
-      scale(1.0f), parent(nullptr), model(nullptr), color(1.0f), visible(true) {}
+    : name(node_name), parent(nullptr), position(0.0f), orientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
+      scale(1.0f), model(nullptr), color(1.0f), visible(true), instanced(false), lod(nullptr), lod_level(0),
+      scene(nullptr), scene_row(-1), local_transform(1.0f), world_transform(1.0f), cached_position(0.0f),
+      cached_orientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)), cached_scale(1.0f),
+      transform_dirty(true), previous_position(0.0f), previous_orientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
+      simulated_position(0.0f), simulated_orientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f)),
+      subtree_model_count(0), bounds_model(nullptr), bounds_child_count(0), bounds_visible(true) {}
 
 SceneNode::~SceneNode() {
     for (auto child : children) {
         delete child;
     }
+    topology_version++;
 }
 
 void SceneNode::AddChild(SceneNode* child) {
     children.push_back(child);
     child->parent = this;
+    child->MarkDirty();
+    topology_version++;
 }
 
-// Get world transformation matrix by combining with parent transformations
-glm::mat4 SceneNode::GetWorldTransform() {
-    glm::mat4 local_transform = glm::mat4(1.0f);
-    local_transform = glm::translate(local_transform, position);
-    local_transform = local_transform * glm::mat4_cast(orientation);
-    local_transform = glm::scale(local_transform, scale);
+void SceneNode::SetPosition(const glm::vec3& value) {
+    position = value;
+    if (scene && scene->positions[scene_row] != value) {
+        scene->positions[scene_row] = value;
+        scene->local_changed[scene_row] = 1;
+    }
+}
 
-    if (parent) {
-        return parent->GetWorldTransform() * local_transform;
+void SceneNode::SetOrientation(const glm::quat& value) {
+    orientation = value;
+    if (scene && scene->orientations[scene_row] != value) {
+        scene->orientations[scene_row] = value;
+        scene->local_changed[scene_row] = 1;
     }
-    return local_transform;
 }
 
-// Draw this node and all children recursively
-void SceneNode::Draw(GLuint program) {
-    // Skip this node and all children if not visible
-    if (!visible) {
-        return;
+void SceneNode::SetScale(const glm::vec3& value) {
+    scale = value;
+    if (scene && scene->scales[scene_row] != value) {
+        scene->scales[scene_row] = value;
+        scene->local_changed[scene_row] = 1;
     }
+}
 
-    if (model) {
-        glm::mat4 world_transform = GetWorldTransform();
+void SceneNode::SetVisible(bool value) {
+    visible = value;
+    if (scene) {
+        scene->node_visible[scene_row] = value ? 1 : 0;
+    }
+}
 
-        // Set world matrix
-        GLint world_mat = glGetUniformLocation(program, "world_mat");
-        glUniformMatrix4fv(world_mat, 1, GL_FALSE, glm::value_ptr(world_transform));
+void SceneNode::SetModel(Model* value) {
+    model = value;
+    if (scene) {
+        scene->models[scene_row] = value;
+        scene->bounding_radii[scene_row] = value ? value->bounding_radius : 0.0f;
+    }
+}
 
-        // Set normal matrix
-        glm::mat4 normal_matrix = glm::transpose(glm::inverse(world_transform));
-        GLint normal_mat = glGetUniformLocation(program, "normal_mat");
-        glUniformMatrix4fv(normal_mat, 1, GL_FALSE, glm::value_ptr(normal_matrix));
+void SceneNode::SetColor(const glm::vec3& value) {
+    color = value;
+    if (scene) {
+        scene->colors[scene_row] = value;
+    }
+}
 
-        // Bind and draw
-        glBindBuffer(GL_ARRAY_BUFFER, model->vbo);
+void SceneNode::SetInstanced(bool value) {
+    instanced = value;
+    if (scene) {
+        scene->instanced[scene_row] = value ? 1 : 0;
+    }
+}
 
-        GLint vertex_att = glGetAttribLocation(program, "vertex");
-        glVertexAttribPointer(vertex_att, 3, GL_FLOAT, GL_FALSE, 9*sizeof(GLfloat), 0);
-        glEnableVertexAttribArray(vertex_att);
+void SceneNode::SetLod(LodChain* value) {
+    lod = value;
+    if (scene) {
+        scene->lods[scene_row] = value;
+    }
+}
 
-        GLint normal_att = glGetAttribLocation(program, "normal");
-        glVertexAttribPointer(normal_att, 3, GL_FLOAT, GL_FALSE, 9*sizeof(GLfloat), (void*)(3*sizeof(GLfloat)));
-        glEnableVertexAttribArray(normal_att);
+const glm::mat4& SceneNode::GetWorldTransform() const {
+    return scene ? scene->world_transforms[scene_row] : world_transform;
+}
 
-        GLint color_att = glGetAttribLocation(program, "color");
-        glVertexAttribPointer(color_att, 3, GL_FLOAT, GL_FALSE, 9*sizeof(GLfloat), (void*)(6*sizeof(GLfloat)));
-        glEnableVertexAttribArray(color_att);
+glm::mat4 SceneNode::ComputeWorldTransform() const {
+    glm::mat4 local = ComposeTrs(position, orientation, scale);
+    return parent ? parent->ComputeWorldTransform() * local : local;
+}
 
-        if (model->use_elements) {
-            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->ebo);
-            glDrawElements(GL_TRIANGLES, model->size, GL_UNSIGNED_INT, 0);
-        } else {
-            glDrawArrays(GL_TRIANGLES, 0, model->size);
+void SceneNode::MarkDirty() {
+    transform_dirty = true;
+    if (scene) {
+        scene->local_changed[scene_row] = 1;
+    }
+}
+
+// A node in a LinearScene saves into its row too, since the scene
+// interpolates from there
+void SceneNode::SaveSimulationState() {
+    previous_position = position;
+    previous_orientation = orientation;
+    if (scene) {
+        scene->previous_positions[scene_row] = position;
+        scene->previous_orientations[scene_row] = orientation;
+    }
+    for (auto child : children) {
+        child->SaveSimulationState();
+    }
+}
+
+// Nodes that did not move during the last steps keep their exact pose, so
+// their cached matrices are not rebuilt
+void SceneNode::BeginInterpolation(float alpha) {
+    simulated_position = position;
+    simulated_orientation = orientation;
+    if (previous_position != position) {
+        position = glm::mix(previous_position, position, alpha);
+    }
+    if (previous_orientation != orientation) {
+        orientation = glm::slerp(previous_orientation, orientation, alpha);
+    }
+    for (auto child : children) {
+        child->BeginInterpolation(alpha);
+    }
+}
+
+void SceneNode::EndInterpolation() {
+    position = simulated_position;
+    orientation = simulated_orientation;
+    for (auto child : children) {
+        child->EndInterpolation();
+    }
+}
+
+// Refresh cached matrices top-down. A node rebuilds its local matrix only when
+// its own position/orientation/scale changed, and its world matrix only when
+// the local matrix or any ancestor's world matrix changed.
+bool SceneNode::UpdateTransforms(bool parent_changed) {
+    if (position != cached_position || orientation != cached_orientation || scale != cached_scale) {
+        transform_dirty = true;
+    }
+
+    if (transform_dirty) {
+        local_transform = ComposeTrs(position, orientation, scale);
+
+        cached_position = position;
+        cached_orientation = orientation;
+        cached_scale = scale;
+        transforms_rebuilt++;
+    }
+
+    bool world_changed = transform_dirty || parent_changed;
+    if (world_changed) {
+        world_transform = parent ? parent->world_transform * local_transform : local_transform;
+        transforms_rebuilt++;
+    }
+    transform_dirty = false;
+
+    // A node shown or hidden changes its parent's bounds, not its own
+    bool subtree_changed = world_changed || model != bounds_model ||
+                           children.size() != bounds_child_count || visible != bounds_visible;
+    bounds_visible = visible;
+    for (auto child : children) {
+        if (child->UpdateTransforms(world_changed)) {
+            subtree_changed = true;
         }
     }
 
-    // Draw children
+    if (subtree_changed) {
+        UpdateBounds();
+    }
+    return subtree_changed;
+}
+
+// Recompute this node's sphere and merge it with the (already updated) child
+// subtrees. Hidden children are left out: Draw() skips them, so they must not
+// widen the sphere or count as culled.
+void SceneNode::UpdateBounds() {
+    world_bounds = model ? BoundingSphere::FromTransform(world_transform, model->bounding_radius)
+                         : BoundingSphere();
+    subtree_bounds = world_bounds;
+    subtree_model_count = model ? 1 : 0;
+
     for (auto child : children) {
-        child->Draw(program);
+        if (!child->visible) continue;
+        subtree_bounds = BoundingSphere::Merge(subtree_bounds, child->subtree_bounds);
+        subtree_model_count += child->subtree_model_count;
     }
+
+    bounds_model = model;
+    bounds_child_count = children.size();
 }
 
 void SceneNode::Update(float delta_time) {
@@ -84,3 +206,15 @@ void SceneNode::Update(float delta_time) {
         child->Update(delta_time);
     }
 }
+
+unsigned int SceneNode::GetTransformsRebuilt() {
+    return transforms_rebuilt;
+}
+
+void SceneNode::ResetTransformStats() {
+    transforms_rebuilt = 0;
+}
+
+unsigned int SceneNode::GetTopologyVersion() {
+    return topology_version;
+}
@@ -0,0 +1,97 @@
+#include "scene_node.h"
+#include "shader_program.h"
+#include "render_context.h"
+#include "instanced_renderer.h"
+#include "mesh_registry.h"
+#include "transform_simd.h"
+#include <glm/gtc/type_ptr.hpp>
+#include <algorithm>
+
+// SceneNode drawing. Kept apart from scene_node.cpp so the simulation can be
+// built without OpenGL.
+
+// Draw this node and all children recursively
+void SceneNode::Draw(RenderContext& context) {
+    // Skip this node and all children if not visible
+    if (!visible) {
+        return;
+    }
+
+    // Reject the whole subtree when its bounding sphere is outside the frustum
+    if (context.frustum) {
+        if (subtree_bounds.IsEmpty()) {
+            return;
+        }
+        if (!context.frustum->Intersects(subtree_bounds)) {
+            context.nodes_culled += subtree_model_count;
+            return;
+        }
+    }
+
+    if (model) {
+        if (context.frustum && !children.empty() && !context.frustum->Intersects(world_bounds)) {
+            context.nodes_culled++;
+        } else {
+            SubmitModel(context, SelectModel(context), world_transform, color, instanced);
+        }
+    }
+
+    // Draw children
+    for (auto child : children) {
+        child->Draw(context);
+    }
+}
+
+const Model* SceneNode::SelectModel(const RenderContext& context) {
+    return SelectLodModel(context, model, lod, world_transform, lod_level);
+}
+
+const Model* SceneNode::SelectLodModel(const RenderContext& context, const Model* model, const LodChain* lod,
+                                       const glm::mat4& world, int& lod_level) {
+    if (!lod || context.lod_scale <= 0.0f) {
+        return model;
+    }
+
+    BoundingSphere sphere = BoundingSphere::FromTransform(world, model->bounding_radius);
+    float distance = std::max(glm::length(sphere.center - context.camera_position), 0.001f);
+    lod_level = lod->Select(context.lod_scale * sphere.radius / distance, lod_level);
+    return lod->levels[lod_level];
+}
+
+void SceneNode::SubmitModel(RenderContext& context, const Model* model, const glm::mat4& world,
+                            const glm::vec3& color, bool instanced) {
+    context.nodes_drawn++;
+    context.triangles += model->size / 3;
+    if (instanced && context.instancing) {
+        context.instancing->Submit(model, world, color);
+    } else {
+        DrawModel(context, model, world, color);
+    }
+}
+
+void SceneNode::DrawModel(RenderContext& context, const Model* model,
+                          const glm::mat4& world, const glm::vec3& color) {
+    const ShaderProgram& program = *context.program;
+
+    // Set world matrix
+    GLint world_mat = program.GetUniform(UniformSlot::WORLD_MAT);
+    glUniformMatrix4fv(world_mat, 1, GL_FALSE, glm::value_ptr(world));
+
+    // Set normal matrix (world matrices are affine, so no full 4x4 inverse)
+    glm::mat4 normal_matrix = AffineNormalMatrix(world);
+    GLint normal_mat = program.GetUniform(UniformSlot::NORMAL_MAT);
+    glUniformMatrix4fv(normal_mat, 1, GL_FALSE, glm::value_ptr(normal_matrix));
+
+    // Meshes carry no per-vertex color; use a constant value for this draw
+    glVertexAttrib3f(COLOR_ATTRIB_LOCATION, color.r, color.g, color.b);
+
+    // Bind the mesh's vertex layout and draw
+    glBindVertexArray(model->vao);
+
+    if (model->use_elements) {
+        glDrawElements(GL_TRIANGLES, model->size, model->index_type, 0);
+    } else {
+        glDrawArrays(GL_TRIANGLES, 0, model->size);
+    }
+    context.draw_calls++;
+}
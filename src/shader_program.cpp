@@ -0,0 +1,186 @@
+#define SHADER_PROGRAM_RAW_LOOKUPS
+#include "shader_program.h"
+#include "model.h"
+#include "frame_uniforms.h"
+#include <algorithm>
+#include <vector>
+
+unsigned int ShaderProgram::name_lookups = 0;
+
+// Names of the well-known slots, in enum order
+static const char* uniform_slot_names[] = {
+    "world_mat", "normal_mat", "timer", "object_color", "color", "textColor"
+};
+static const char* attrib_slot_names[] = {
+    "vertex", "normal", "color"
+};
+
+ShaderProgram::ShaderProgram() : id(0) {
+    for (auto& location : uniform_slots) location = -1;
+    for (auto& location : attrib_slots) location = -1;
+}
+
+ShaderProgram::~ShaderProgram() {
+    if (id != 0) {
+        glDeleteProgram(id);
+    }
+}
+
+GLuint ShaderProgram::CompileShader(GLenum type, const char* source, const char* label) {
+    GLuint shader = glCreateShader(type);
+
+    // Insert the FrameData block right after the #version line, then reset the
+    // line counter so compiler messages still match the original source
+    std::string text(source);
+    size_t version = text.find("#version");
+    if (version != std::string::npos) {
+        size_t line_end = text.find('\n', version);
+        if (line_end == std::string::npos) line_end = text.size();
+        int next_line = static_cast<int>(std::count(text.begin(), text.begin() + line_end, '\n')) + 2;
+
+        std::string header = text.substr(0, line_end) + FRAME_DATA_GLSL +
+                             "#line " + std::to_string(next_line) + "\n";
+        text = header + (line_end < text.size() ? text.substr(line_end + 1) : std::string());
+    }
+
+    const char* full_source = text.c_str();
+    glShaderSource(shader, 1, &full_source, NULL);
+    glCompileShader(shader);
+
+    GLint status;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+    if (status != GL_TRUE) {
+        char buffer[512];
+        glGetShaderInfoLog(shader, 512, NULL, buffer);
+        log = std::string("Error compiling ") + label + " shader: " + buffer;
+        glDeleteShader(shader);
+        return 0;
+    }
+    return shader;
+}
+
+bool ShaderProgram::Load(const char* vertex_source, const char* fragment_source,
+                         const char* geometry_source) {
+    GLuint vs = CompileShader(GL_VERTEX_SHADER, vertex_source, "vertex");
+    if (vs == 0) return false;
+
+    GLuint gs = 0;
+    if (geometry_source) {
+        gs = CompileShader(GL_GEOMETRY_SHADER, geometry_source, "geometry");
+        if (gs == 0) {
+            glDeleteShader(vs);
+            return false;
+        }
+    }
+
+    GLuint fs = CompileShader(GL_FRAGMENT_SHADER, fragment_source, "fragment");
+    if (fs == 0) {
+        glDeleteShader(vs);
+        if (gs) glDeleteShader(gs);
+        return false;
+    }
+
+    id = glCreateProgram();
+    glAttachShader(id, vs);
+    if (gs) glAttachShader(id, gs);
+    glAttachShader(id, fs);
+
+    // Pin mesh attributes to the locations baked into every model VAO
+    // (explicit layout qualifiers in the shader take precedence)
+    glBindAttribLocation(id, VERTEX_ATTRIB_LOCATION, "vertex");
+    glBindAttribLocation(id, NORMAL_ATTRIB_LOCATION, "normal");
+    glBindAttribLocation(id, COLOR_ATTRIB_LOCATION, "color");
+    glBindAttribLocation(id, INSTANCE_WORLD_ATTRIB_LOCATION, "instance_world");
+    glLinkProgram(id);
+
+    glDeleteShader(vs);
+    if (gs) glDeleteShader(gs);
+    glDeleteShader(fs);
+
+    GLint status;
+    glGetProgramiv(id, GL_LINK_STATUS, &status);
+    if (status != GL_TRUE) {
+        char buffer[512];
+        glGetProgramInfoLog(id, 512, NULL, buffer);
+        log = std::string("Error linking shaders: ") + buffer;
+        glDeleteProgram(id);
+        id = 0;
+        return false;
+    }
+
+    // Every program reads per-frame data from the same uniform buffer
+    GLuint frame_block = glGetUniformBlockIndex(id, "FrameData");
+    if (frame_block != GL_INVALID_INDEX) {
+        glUniformBlockBinding(id, frame_block, FRAME_UNIFORM_BINDING);
+    }
+
+    Reflect();
+    return true;
+}
+
+// Enumerate every active uniform and attribute once and cache its location
+void ShaderProgram::Reflect() {
+    GLint count = 0;
+    GLint max_length = 0;
+    std::vector<GLchar> name;
+
+    glGetProgramiv(id, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(id, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+    name.resize(max_length > 0 ? max_length : 1);
+    for (GLint i = 0; i < count; i++) {
+        GLint size;
+        GLenum type;
+        GLsizei length;
+        glGetActiveUniform(id, i, static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+
+        // Arrays are reported as "name[0]"; cache them under the base name
+        std::string uniform_name(name.data(), length);
+        size_t bracket = uniform_name.find('[');
+        if (bracket != std::string::npos) {
+            uniform_name = uniform_name.substr(0, bracket);
+        }
+        uniforms[uniform_name] = LookUpUniformLocation(id, name.data());
+    }
+
+    glGetProgramiv(id, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(id, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &max_length);
+    name.resize(max_length > 0 ? max_length : 1);
+    for (GLint i = 0; i < count; i++) {
+        GLint size;
+        GLenum type;
+        GLsizei length;
+        glGetActiveAttrib(id, i, static_cast<GLsizei>(name.size()), &length, &size, &type, name.data());
+        attributes[std::string(name.data(), length)] = LookUpAttribLocation(id, name.data());
+    }
+
+    for (int i = 0; i < static_cast<int>(UniformSlot::COUNT); i++) {
+        auto it = uniforms.find(uniform_slot_names[i]);
+        uniform_slots[i] = (it != uniforms.end()) ? it->second : -1;
+    }
+    for (int i = 0; i < static_cast<int>(AttribSlot::COUNT); i++) {
+        auto it = attributes.find(attrib_slot_names[i]);
+        attrib_slots[i] = (it != attributes.end()) ? it->second : -1;
+    }
+}
+
+void ShaderProgram::Use() const {
+    glUseProgram(id);
+}
+
+GLint ShaderProgram::LookUpUniformLocation(GLuint program, const GLchar* name) {
+    name_lookups++;
+    return glGetUniformLocation(program, name);
+}
+
+GLint ShaderProgram::LookUpAttribLocation(GLuint program, const GLchar* name) {
+    name_lookups++;
+    return glGetAttribLocation(program, name);
+}
+
+unsigned int ShaderProgram::GetNameLookups() {
+    return name_lookups;
+}
+
+void ShaderProgram::ResetNameLookups() {
+    name_lookups = 0;
+}
@@ -0,0 +1,646 @@
+#include "simulation.h"
+#include "systems.h"
+#include "collision.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <glm/gtc/constants.hpp>
+
+const char* GetBroadphaseName(Broadphase broadphase) {
+    switch (broadphase) {
+        case Broadphase::GRID: return "GRID";
+        case Broadphase::BVH: return "BVH";
+        default: return "BRUTE FORCE";
+    }
+}
+
+// Items per job when spreading work over threads
+const size_t PROJECTILES_PER_JOB = 8;
+const size_t ASTEROIDS_PER_JOB = 4096;
+
+Simulation::Simulation(GameManager* game_manager, JobSystem* job_system, uint64_t run_seed)
+    : root(nullptr), ship(nullptr), cannon_root(nullptr), game(game_manager), jobs(job_system),
+      lasers(50.0f, 3.0f, 0.0f, glm::vec3(0.2f, 0.2f, 5.0f)),  // Long thin beam
+      missiles(30.0f, 5.0f, 5.0f, glm::vec3(0.3f, 0.3f, 1.0f)),  // Spins for visual effect
+      laser_capacity(64), missile_capacity(32), field_layout(FieldLayout::RINGS),
+      broadphase(Broadphase::GRID), use_swept_collision(true), simd_level(GetBestSimdLevel()),
+      collision_tests(0), detect_microseconds(0.0f), resolve_microseconds(0.0f),
+      field_chunks_loaded(0), field_generate_microseconds(0.0f),
+      field_random(run_seed, RandomStream::ASTEROID_FIELD), asteroid_grid(8.0f), asteroid_tree(1.0f),
+      scratch(job_system->GetThreadCount()), ship_tests(0), step_delta_time(0.0f) {
+    BuildStepGraph();
+}
+
+Simulation::~Simulation() {
+    DestroyWorld();
+}
+
+void Simulation::CreateWorld(int asteroid_count) {
+    root = new SceneNode("Root");
+
+    ship = new SceneNode("Ship");
+    root->AddChild(ship);
+    ship_transform.position = glm::vec3(0.0f, 0.0f, 0.0f);
+    ship_transform.orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    ship_motion = ShipMotion();
+
+    if (field_layout == FieldLayout::STREAMED) {
+        field.Create();
+        asteroid_count = static_cast<int>(field.GetRowCapacity());
+    }
+    Collider asteroid_collider;
+    asteroid_collider.radius = 1.5f * 1.5f;  // Unit-radius 1.5 sphere drawn at scale 1.5
+    asteroid_collider.proxy = -1;
+    asteroids.positions.assign(asteroid_count, glm::vec3(0.0f));
+    asteroids.orientations.assign(asteroid_count, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    asteroids.colliders.assign(asteroid_count, asteroid_collider);
+    asteroids.live.assign(asteroid_count, field_layout == FieldLayout::RINGS ? 1 : 0);
+    asteroids.entities.assign(asteroid_count, EntityHandle());
+    asteroids.nodes.resize(asteroid_count);
+    for (int i = 0; i < asteroid_count; i++) {
+        SceneNode* node = new SceneNode("Asteroid");
+        node->SetInstanced(true);
+        node->SetScale(glm::vec3(1.5f));
+        asteroids.nodes[i] = node;
+        root->AddChild(node);
+    }
+    if (field_layout == FieldLayout::RINGS) {
+        PlaceAsteroids();
+    }
+
+    cannon_root = new SceneNode("CannonBase");
+    cannon_root->SetPosition(glm::vec3(-30.0f, 0.0f, 0.0f));
+    root->AddChild(cannon_root);
+
+    CreateProjectiles(lasers, laser_pool, laser_capacity, "Laser");
+    CreateProjectiles(missiles, missile_pool, missile_capacity, "Missile");
+    RegisterEntities();
+    if (field_layout == FieldLayout::STREAMED) {
+        field.Reset(NextFieldSeed());
+        StreamAsteroidField(static_cast<int>(field.GetBlockCapacity()));
+    }
+    SyncNodes();
+}
+
+// Inactive projectile rows with hidden render nodes, all free in the pool
+void Simulation::CreateProjectiles(ProjectileComponents& projectiles, ProjectilePool& pool, size_t capacity,
+                                   const char* name) {
+    Velocity still;
+    still.linear = glm::vec3(0.0f);
+    Lifetime unused;
+    unused.age = 0.0f;
+    unused.max_age = projectiles.max_lifetime;
+    Collider beam;
+    beam.radius = 0.5f * glm::length(projectiles.scale);
+    beam.proxy = -1;
+
+    projectiles.positions.assign(capacity, glm::vec3(0.0f));
+    projectiles.orientations.assign(capacity, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    projectiles.velocities.assign(capacity, still);
+    projectiles.lifetimes.assign(capacity, unused);
+    projectiles.colliders.assign(capacity, beam);
+    projectiles.active.assign(capacity, 0);
+    projectiles.entities.assign(capacity, EntityHandle());
+    projectiles.nodes.resize(capacity);
+    for (size_t i = 0; i < capacity; i++) {
+        SceneNode* node = new SceneNode(name);
+        node->SetInstanced(true);
+        node->SetScale(projectiles.scale);
+        node->SetVisible(false);
+        projectiles.nodes[i] = node;
+        root->AddChild(node);
+    }
+    pool.Create(capacity);
+}
+
+void Simulation::DestroyWorld() {
+    delete root;
+    root = nullptr;
+    ship = nullptr;
+    cannon_root = nullptr;
+    asteroids.Clear();
+    lasers.Clear();
+    missiles.Clear();
+    laser_pool.Clear();
+    missile_pool.Clear();
+    entities.Clear();
+    events.clear();
+    asteroid_tree.Clear();
+    field.Clear();
+}
+
+void Simulation::ResetWorld() {
+    ship_transform.position = glm::vec3(0.0f, 0.0f, 0.0f);
+    ship_transform.orientation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    ship_motion = ShipMotion();
+
+    // Rebuild the BVH from scratch, as for a new world
+    ClearAsteroidTree();
+    for (size_t i = 0; i < asteroids.GetCount(); i++) {
+        asteroids.orientations[i] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+        asteroids.live[i] = field_layout == FieldLayout::RINGS ? 1 : 0;
+    }
+    if (field_layout == FieldLayout::RINGS) {
+        PlaceAsteroids();
+    }
+
+    cannon_root->SetOrientation(glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    std::fill(lasers.active.begin(), lasers.active.end(), 0);
+    std::fill(missiles.active.begin(), missiles.active.end(), 0);
+    laser_pool.Reset();
+    missile_pool.Reset();
+    events.clear();
+
+    // New handles for the new game; any kept from the last one are now stale
+    entities.Clear();
+    RegisterEntities();
+
+    // A streamed field starts over with a new seed around the origin. Only
+    // the ship's chunk is generated here; the steps that follow bring in the
+    // rest, nearest first, so a restart stays as cheap as with the rings.
+    if (field_layout == FieldLayout::STREAMED) {
+        field.Reset(NextFieldSeed());
+        StreamAsteroidField(1);
+    }
+}
+
+// Asteroids on concentric rings; larger fields get more and taller rings
+void Simulation::PlaceAsteroids() {
+    int asteroid_count = static_cast<int>(asteroids.GetCount());
+    int rings = std::max(3, (int)std::cbrt((float)asteroid_count));
+    float spread = (float)rings / 3.0f;
+    for (int i = 0; i < asteroid_count; i++) {
+        float angle = (float)i / (float)asteroid_count * 2.0f * glm::pi<float>();
+        float distance = 20.0f + (i % rings) * 15.0f;
+        asteroids.positions[i] = glm::vec3(cos(angle) * distance, field_random.NextInt(-10, 9) * 0.5f * spread, sin(angle) * distance);
+    }
+}
+
+uint64_t Simulation::NextFieldSeed() {
+    uint64_t high = field_random.NextUInt();
+    return (high << 32) | field_random.NextUInt();
+}
+
+// Load and unload chunks around the ship, generating at most max_loads. The
+// rows of an unloaded chunk leave the BVH and get new handles, so nothing
+// kept from outside the step reaches whatever is generated there next. Newly
+// loaded chunks are generated in parallel, one per job, each into its own
+// block of rows.
+void Simulation::StreamAsteroidField(int max_loads) {
+    if (field_layout != FieldLayout::STREAMED) return;
+    field.Update(ship_transform.position, max_loads);
+
+    size_t block_rows = static_cast<size_t>(field.settings.max_asteroids);
+    Entity entity;
+    entity.type = EntityType::ASTEROID;
+    for (int block : field.GetEvictedBlocks()) {
+        size_t first_row = field.GetFirstRow(block);
+        for (size_t row = first_row; row < first_row + block_rows; row++) {
+            DestroyAsteroid(row);
+            entities.Remove(asteroids.entities[row]);
+            entity.index = static_cast<int>(row);
+            asteroids.entities[row] = entities.Insert(entity);
+        }
+    }
+
+    const std::vector<int>& loaded = field.GetLoadedBlocks();
+    if (loaded.empty()) return;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    jobs->ParallelFor(loaded.size(), 1, [this, &loaded](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            field.GenerateBlock(loaded[i], asteroids);
+        }
+    });
+    field_chunks_loaded = loaded.size();
+    field_generate_microseconds =
+        std::chrono::duration<float, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Give every entity of the world a handle, in a fixed order so the handles
+// of a new world do not depend on what happened in the last one
+void Simulation::RegisterEntities() {
+    Entity entity;
+    entity.type = EntityType::SHIP;
+    entity.index = 0;
+    ship_entity = entities.Insert(entity);
+
+    entity.type = EntityType::ASTEROID;
+    for (size_t i = 0; i < asteroids.GetCount(); i++) {
+        entity.index = static_cast<int>(i);
+        asteroids.entities[i] = entities.Insert(entity);
+    }
+    entity.type = EntityType::LASER;
+    for (size_t i = 0; i < lasers.GetCount(); i++) {
+        entity.index = static_cast<int>(i);
+        lasers.entities[i] = entities.Insert(entity);
+    }
+    entity.type = EntityType::MISSILE;
+    for (size_t i = 0; i < missiles.GetCount(); i++) {
+        entity.index = static_cast<int>(i);
+        missiles.entities[i] = entities.Insert(entity);
+    }
+}
+
+void Simulation::SyncNodes() {
+    ship->SetPosition(ship_transform.position);
+    ship->SetOrientation(ship_transform.orientation);
+    jobs->ParallelFor(asteroids.GetCount(), ASTEROIDS_PER_JOB, [this](size_t begin, size_t end) {
+        SyncAsteroidNodes(asteroids, begin, end);
+    });
+    SyncProjectileNodes(lasers);
+    SyncProjectileNodes(missiles);
+
+    // Asteroids of chunks loaded this step appear in place instead of
+    // sliding over from where their rows were last drawn
+    size_t block_rows = static_cast<size_t>(field.settings.max_asteroids);
+    for (int block : field.GetLoadedBlocks()) {
+        size_t first_row = field.GetFirstRow(block);
+        for (size_t row = first_row; row < first_row + block_rows; row++) {
+            asteroids.nodes[row]->SaveSimulationState();
+        }
+    }
+}
+
+const glm::vec3* Simulation::GetPosition(EntityHandle handle) const {
+    const Entity* entity = entities.Get(handle);
+    if (!entity) return nullptr;
+    switch (entity->type) {
+        case EntityType::SHIP: return &ship_transform.position;
+        case EntityType::ASTEROID: return &asteroids.positions[entity->index];
+        case EntityType::LASER: return &lasers.positions[entity->index];
+        default: return &missiles.positions[entity->index];
+    }
+}
+
+EntityHandle Simulation::FireLaser() {
+    return LaunchProjectile(lasers, laser_pool);
+}
+
+EntityHandle Simulation::FireMissile() {
+    return LaunchProjectile(missiles, missile_pool);
+}
+
+EntityHandle Simulation::LaunchProjectile(ProjectileComponents& projectiles, ProjectilePool& pool) {
+    int slot = pool.Acquire();
+    if (slot == -1) return EntityHandle();
+
+    // Each shot gets a new handle, so handles to the last projectile fired
+    // from this slot (expired, hit or recycled) go stale
+    Entity entity = *entities.Get(projectiles.entities[slot]);
+    entities.Remove(projectiles.entities[slot]);
+    projectiles.entities[slot] = entities.Insert(entity);
+
+    glm::vec3 fire_pos = ship_transform.position + QuatForward(ship_transform.orientation) * 2.0f;
+    FireProjectile(projectiles, slot, fire_pos, ship_transform.orientation);
+
+    // Appear at the muzzle instead of sliding from the last position
+    SceneNode* node = projectiles.nodes[slot];
+    node->SetPosition(fire_pos);
+    node->SetOrientation(ship_transform.orientation);
+    node->SetVisible(true);
+    node->SaveSimulationState();
+    return projectiles.entities[slot];
+}
+
+// Stop a projectile that hit something and free its slot
+void Simulation::ReleaseProjectile(ProjectileComponents& projectiles, ProjectilePool& pool, size_t slot) {
+    projectiles.active[slot] = 0;
+    pool.Release(slot);
+}
+
+void Simulation::Step(float delta_time) {
+    events.clear();
+    if (game->current_state != GameState::PLAYING) {
+        return;
+    }
+
+    game->game_time += delta_time;
+    step_delta_time = delta_time;
+    jobs->Run(step_graph);
+}
+
+// One step as a job graph:
+//
+//   ship update --> field streaming --> broadphase --+--> projectile collisions --+--> resolve --> asteroid spin
+//                                                    +--> ship collisions -------+
+//   cannon animation (independent)
+//
+// Detection only moves projectiles and records contacts; nothing reads what
+// another job of the same stage writes.
+void Simulation::BuildStepGraph() {
+    JobGraph::JobId update_ship = step_graph.Add([this]() { UpdateShip(ship_motion, ship_transform, step_delta_time); });
+    JobGraph::JobId stream_field = step_graph.Add([this]() { StreamAsteroidField(field.settings.chunks_per_step); });
+    JobGraph::JobId refresh_broadphase = step_graph.Add([this]() {
+        detect_start = std::chrono::steady_clock::now();
+        UpdateBroadphase();
+    });
+    JobGraph::JobId detect_projectiles = step_graph.Add([this]() { DetectProjectileCollisions(); });
+    JobGraph::JobId detect_ship = step_graph.Add([this]() { DetectShipCollisions(); });
+    JobGraph::JobId resolve = step_graph.Add([this]() {
+        std::chrono::steady_clock::time_point resolve_start = std::chrono::steady_clock::now();
+        ResolveCollisions();
+        std::chrono::steady_clock::time_point resolve_end = std::chrono::steady_clock::now();
+        detect_microseconds = std::chrono::duration<float, std::micro>(resolve_start - detect_start).count();
+        resolve_microseconds = std::chrono::duration<float, std::micro>(resolve_end - resolve_start).count();
+    });
+    JobGraph::JobId spin_asteroids = step_graph.Add([this]() { RotateAsteroids(); });
+
+    // Cannon animation, driven by simulated time so it advances with the fixed steps
+    step_graph.Add([this]() {
+        if (cannon_root) {
+            cannon_root->SetOrientation(glm::angleAxis(game->game_time * 0.3f, glm::vec3(0.0f, 1.0f, 0.0f)));
+        }
+    });
+
+    step_graph.Depend(stream_field, update_ship);
+    step_graph.Depend(refresh_broadphase, stream_field);
+    step_graph.Depend(detect_projectiles, refresh_broadphase);
+    step_graph.Depend(detect_ship, refresh_broadphase);
+    step_graph.Depend(resolve, detect_projectiles);
+    step_graph.Depend(resolve, detect_ship);
+    step_graph.Depend(spin_asteroids, resolve);
+}
+
+// Only the selected broadphase is kept up to date. The BVH is emptied while
+// another one is in use and rebuilt from the live rows when it is selected again.
+void Simulation::UpdateBroadphase() {
+    if (broadphase == Broadphase::GRID) {
+        RebuildAsteroidGrid();
+    } else if (broadphase == Broadphase::BRUTE_FORCE) {
+        RebuildAsteroidSpheres();
+    } else {
+        UpdateAsteroidTree();
+    }
+    if (broadphase != Broadphase::BVH && asteroid_tree.GetProxyCount() > 0) {
+        ClearAsteroidTree();
+    }
+}
+
+// Insert every live asteroid into the broadphase grid
+void Simulation::RebuildAsteroidGrid() {
+    asteroid_grid.Clear();
+    for (size_t i = 0; i < asteroids.GetCount(); i++) {
+        if (asteroids.live[i]) {
+            asteroid_grid.Insert(static_cast<int>(i), asteroids.positions[i], asteroids.colliders[i].radius);
+        }
+    }
+    asteroid_grid.Build();
+}
+
+// Copy live asteroid centers and radii into asteroid_spheres
+void Simulation::RebuildAsteroidSpheres() {
+    asteroid_spheres.Clear();
+    for (size_t i = 0; i < asteroids.GetCount(); i++) {
+        if (asteroids.live[i]) {
+            asteroid_spheres.Add(asteroids.positions[i], asteroids.colliders[i].radius, static_cast<int>(i));
+        }
+    }
+}
+
+// Empty the BVH, keeping its node storage; the next UpdateAsteroidTree()
+// inserts every live asteroid again
+void Simulation::ClearAsteroidTree() {
+    asteroid_tree.Clear();
+    for (size_t i = 0; i < asteroids.GetCount(); i++) {
+        asteroids.colliders[i].proxy = -1;
+    }
+}
+
+// Keep one BVH proxy per live asteroid. Proxies of destroyed asteroids are
+// removed; the rest are moved, which only restructures the tree when an
+// asteroid leaves its fattened box.
+void Simulation::UpdateAsteroidTree() {
+    for (size_t i = 0; i < asteroids.GetCount(); i++) {
+        Collider& collider = asteroids.colliders[i];
+        if (!asteroids.live[i]) {
+            if (collider.proxy != -1) {
+                asteroid_tree.DestroyProxy(collider.proxy);
+                collider.proxy = -1;
+            }
+        } else if (collider.proxy == -1) {
+            collider.proxy = asteroid_tree.CreateProxy(asteroids.positions[i], collider.radius,
+                                                       static_cast<int>(i));
+        } else {
+            asteroid_tree.MoveProxy(collider.proxy, asteroids.positions[i], collider.radius);
+        }
+    }
+}
+
+// Fill candidates with the indices of asteroids that may touch a sphere of
+// the given radius swept from start to end (ascending asteroid order)
+void Simulation::FindAsteroidCandidates(const glm::vec3& start, const glm::vec3& end, float radius,
+                                        std::vector<int>& candidates) const {
+    candidates.clear();
+    if (broadphase == Broadphase::GRID) {
+        asteroid_grid.QuerySegment(start, end, radius, candidates);
+    } else if (broadphase == Broadphase::BVH) {
+        asteroid_tree.QuerySphere(end, radius + glm::length(end - start), candidates);
+        std::sort(candidates.begin(), candidates.end());
+    } else {
+        for (size_t i = 0; i < asteroids.GetCount(); i++) {
+            candidates.push_back(static_cast<int>(i));
+        }
+    }
+}
+
+// Index of the asteroid a projectile hits this tick, or -1. The beam covers
+// half_length either side of its position, so over the tick it sweeps the
+// segment from behind its previous position to ahead of its new one. The
+// swept test returns the asteroid with the earliest time of impact along
+// that segment (the BVH finds it directly); the legacy line test takes the
+// first candidate in index order, including asteroids behind the beam, with
+// every broadphase gathering candidates around the segment.
+// time_of_impact is the fraction of the swept segment before contact (1 for
+// the line test, which has no notion of when the hit happened). Narrowphase
+// tests are added to tests.
+int Simulation::FindProjectileHit(const glm::vec3& previous_position, const glm::vec3& position,
+                                  const glm::vec3& direction, float half_length, CollisionScratch& buffers,
+                                  unsigned int& tests, float& time_of_impact) const {
+    glm::vec3 sweep_start = previous_position - direction * half_length;
+    glm::vec3 sweep_end = position + direction * half_length;
+
+    if (broadphase == Broadphase::BVH && use_swept_collision) {
+        BvhHit hit;
+        tests++;
+        if (asteroid_tree.SegmentCast(sweep_start, sweep_end, hit)) {
+            time_of_impact = hit.distance / glm::length(sweep_end - sweep_start);
+            return hit.user_id;
+        }
+        return -1;
+    }
+
+    if (broadphase == Broadphase::BRUTE_FORCE && use_swept_collision) {
+        // Test every asteroid, 4 or 8 per instruction, then take the earliest impact
+        SegmentSphereBatch(simd_level, asteroid_spheres, sweep_start, sweep_end,
+                           buffers.hit_mask, buffers.impact_times);
+        tests += static_cast<unsigned int>(asteroid_spheres.GetCount());
+        int closest = -1;
+        for (size_t word = 0; word < buffers.hit_mask.size(); word++) {
+            uint32_t bits = buffers.hit_mask[word];
+            for (size_t slot = word * 32; bits != 0; slot++, bits >>= 1) {
+                if ((bits & 1) && (closest == -1 || buffers.impact_times[slot] < buffers.impact_times[closest])) {
+                    closest = static_cast<int>(slot);
+                }
+            }
+        }
+        if (closest == -1) return -1;
+        time_of_impact = buffers.impact_times[closest];
+        return asteroid_spheres.user_id[closest];
+    }
+
+    FindAsteroidCandidates(previous_position, position, half_length, buffers.candidates);
+    int closest = -1;
+    float closest_time = 1.0f;
+    for (int index : buffers.candidates) {
+        if (asteroids.live[index]) {
+            const glm::vec3& center = asteroids.positions[index];
+            float radius = asteroids.colliders[index].radius;
+            tests++;
+            if (!use_swept_collision) {
+                if (RayIntersectsSphere(position, direction, center, radius)) {
+                    time_of_impact = 1.0f;
+                    return index;
+                }
+            } else {
+                float time;
+                if (SegmentSphereTimeOfImpact(sweep_start, sweep_end, center, radius, time) &&
+                    (closest == -1 || time < closest_time)) {
+                    closest = index;
+                    closest_time = time;
+                }
+            }
+        }
+    }
+    time_of_impact = closest_time;
+    return closest;
+}
+
+// Move a projectile and record in its slot whether it hit an asteroid this tick
+void Simulation::DetectProjectileCollision(ProjectileComponents& projectiles, size_t row, size_t slot,
+                                           CollisionType type) {
+    CollisionEvent& event = projectile_hits[slot];
+    event.asteroid = EntityHandle();
+    projectile_tests[slot] = 0;
+
+    glm::vec3 previous_position = projectiles.positions[row];
+    if (!AdvanceProjectile(projectiles, row, step_delta_time)) return;
+
+    const glm::vec3& position = projectiles.positions[row];
+    glm::vec3 direction = projectiles.velocities[row].linear / projectiles.speed;
+    float half_length = projectiles.colliders[row].radius;
+    float time_of_impact;
+    int index = FindProjectileHit(previous_position, position, direction, half_length,
+                                  scratch[jobs->GetThreadIndex()], projectile_tests[slot], time_of_impact);
+    if (index != -1) {
+        glm::vec3 sweep_start = previous_position - direction * half_length;
+        glm::vec3 sweep_end = position + direction * half_length;
+        event.type = type;
+        event.asteroid = asteroids.entities[index];
+        event.other = projectiles.entities[row];
+        event.point = glm::mix(sweep_start, sweep_end, time_of_impact);
+        event.time = time_of_impact;
+    }
+}
+
+// Lasers and missiles are independent of each other, so they are moved and
+// tested in parallel, a few per job
+void Simulation::DetectProjectileCollisions() {
+    size_t laser_count = lasers.GetCount();
+    size_t slot_count = laser_count + missiles.GetCount();
+    projectile_hits.resize(slot_count);
+    projectile_tests.resize(slot_count);
+
+    jobs->ParallelFor(slot_count, PROJECTILES_PER_JOB, [this, laser_count](size_t begin, size_t end) {
+        for (size_t slot = begin; slot < end; slot++) {
+            if (slot < laser_count) {
+                DetectProjectileCollision(lasers, slot, slot, CollisionType::LASER_ASTEROID);
+            } else {
+                DetectProjectileCollision(missiles, slot - laser_count, slot, CollisionType::MISSILE_ASTEROID);
+            }
+        }
+    });
+}
+
+void Simulation::DetectShipCollisions() {
+    ship_hits.clear();
+    ship_tests = 0;
+
+    float ship_radius = 1.5f;
+    std::vector<int>& candidates = scratch[jobs->GetThreadIndex()].candidates;
+    const glm::vec3& ship_position = ship_transform.position;
+    FindAsteroidCandidates(ship_position, ship_position, ship_radius, candidates);
+    for (int index : candidates) {
+        if (asteroids.live[index]) {
+            ship_tests++;
+            if (SpheresOverlap(asteroids.positions[index], asteroids.colliders[index].radius,
+                               ship_position, ship_radius)) {
+                CollisionEvent event;
+                event.type = CollisionType::SHIP_ASTEROID;
+                event.asteroid = asteroids.entities[index];
+                event.other = ship_entity;
+                event.point = ship_position;
+                event.time = 1.0f;
+                ship_hits.push_back(event);
+            }
+        }
+    }
+}
+
+// Remove a hit asteroid from play and from the BVH
+void Simulation::DestroyAsteroid(size_t index) {
+    asteroids.live[index] = 0;
+    Collider& collider = asteroids.colliders[index];
+    if (collider.proxy != -1) {
+        asteroid_tree.DestroyProxy(collider.proxy);
+        collider.proxy = -1;
+    }
+}
+
+// Gather this tick's contacts (lasers, then missiles, then the ship) and
+// apply them in that order. An asteroid can be reported by several events;
+// the first one destroys it and the others are dropped (their projectile
+// stays in flight), so only applied events remain.
+void Simulation::ResolveCollisions() {
+    laser_pool.ReleaseInactive(lasers.active);
+    missile_pool.ReleaseInactive(missiles.active);
+
+    collision_tests = ship_tests;
+    for (size_t slot = 0; slot < projectile_hits.size(); slot++) {
+        collision_tests += projectile_tests[slot];
+        if (!projectile_hits[slot].asteroid.IsNull()) {
+            events.push_back(projectile_hits[slot]);
+        }
+    }
+    events.insert(events.end(), ship_hits.begin(), ship_hits.end());
+
+    size_t applied = 0;
+    for (size_t i = 0; i < events.size(); i++) {
+        const CollisionEvent& event = events[i];
+        int asteroid = entities.Get(event.asteroid)->index;
+        if (!asteroids.live[asteroid]) continue;
+        DestroyAsteroid(asteroid);
+
+        switch (event.type) {
+            case CollisionType::LASER_ASTEROID:
+                ReleaseProjectile(lasers, laser_pool, entities.Get(event.other)->index);
+                game->AddScore(100);
+                break;
+            case CollisionType::MISSILE_ASTEROID:
+                ReleaseProjectile(missiles, missile_pool, entities.Get(event.other)->index);
+                game->AddScore(150);
+                break;
+            case CollisionType::SHIP_ASTEROID:
+                game->TakeDamage(20);
+                break;
+        }
+        events[applied++] = event;
+    }
+    events.resize(applied);
+}
+
+void Simulation::RotateAsteroids() {
+    glm::quat rotation = glm::angleAxis(step_delta_time * 0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+    jobs->ParallelFor(asteroids.GetCount(), ASTEROIDS_PER_JOB, [this, rotation](size_t begin, size_t end) {
+        SpinAsteroids(asteroids, rotation, simd_level, begin, end);
+    });
+}
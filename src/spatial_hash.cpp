@@ -0,0 +1,102 @@
+#include "spatial_hash.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialHash::SpatialHash(float cell_size)
+    : cell_size(cell_size), inv_cell_size(1.0f / cell_size), object_count(0), bucket_mask(0) {
+    bucket_start.assign(2, 0);
+}
+
+void SpatialHash::SetCellSize(float size) {
+    cell_size = size;
+    inv_cell_size = 1.0f / size;
+}
+
+void SpatialHash::Clear() {
+    entries.clear();
+    object_count = 0;
+}
+
+glm::ivec3 SpatialHash::CellOf(const glm::vec3& point) const {
+    return glm::ivec3(static_cast<int>(std::floor(point.x * inv_cell_size)),
+                      static_cast<int>(std::floor(point.y * inv_cell_size)),
+                      static_cast<int>(std::floor(point.z * inv_cell_size)));
+}
+
+// Teschner et al., "Optimized Spatial Hashing for Collision Detection of Deformable Objects"
+uint32_t SpatialHash::HashCell(int x, int y, int z) {
+    return (static_cast<uint32_t>(x) * 73856093u) ^
+           (static_cast<uint32_t>(y) * 19349663u) ^
+           (static_cast<uint32_t>(z) * 83492791u);
+}
+
+void SpatialHash::Insert(int id, const glm::vec3& center, float radius) {
+    glm::ivec3 min = CellOf(center - glm::vec3(radius));
+    glm::ivec3 max = CellOf(center + glm::vec3(radius));
+
+    for (int x = min.x; x <= max.x; x++) {
+        for (int y = min.y; y <= max.y; y++) {
+            for (int z = min.z; z <= max.z; z++) {
+                entries.push_back(Entry{HashCell(x, y, z), id});
+            }
+        }
+    }
+    object_count++;
+}
+
+void SpatialHash::Build() {
+    // Roughly two buckets per entry keeps hash collisions rare
+    uint32_t bucket_count = 64;
+    while (bucket_count < entries.size() * 2) {
+        bucket_count <<= 1;
+    }
+    bucket_mask = bucket_count - 1;
+
+    // Counting sort of the entries by bucket
+    bucket_start.assign(bucket_count + 1, 0);
+    for (const auto& entry : entries) {
+        bucket_start[(entry.hash & bucket_mask) + 1]++;
+    }
+    for (uint32_t b = 0; b < bucket_count; b++) {
+        bucket_start[b + 1] += bucket_start[b];
+    }
+
+    sorted_ids.resize(entries.size());
+    bucket_cursor.assign(bucket_start.begin(), bucket_start.end() - 1);
+    for (const auto& entry : entries) {
+        sorted_ids[bucket_cursor[entry.hash & bucket_mask]++] = entry.id;
+    }
+}
+
+void SpatialHash::QueryBox(const glm::vec3& min_point, const glm::vec3& max_point,
+                           std::vector<int>& result) const {
+    if (sorted_ids.empty()) return;
+
+    size_t first = result.size();
+    glm::ivec3 min = CellOf(min_point);
+    glm::ivec3 max = CellOf(max_point);
+
+    for (int x = min.x; x <= max.x; x++) {
+        for (int y = min.y; y <= max.y; y++) {
+            for (int z = min.z; z <= max.z; z++) {
+                uint32_t bucket = HashCell(x, y, z) & bucket_mask;
+                for (uint32_t i = bucket_start[bucket]; i < bucket_start[bucket + 1]; i++) {
+                    result.push_back(sorted_ids[i]);
+                }
+            }
+        }
+    }
+
+    // Objects spanning several cells show up once per cell
+    std::sort(result.begin() + first, result.end());
+    result.erase(std::unique(result.begin() + first, result.end()), result.end());
+}
+
+void SpatialHash::QuerySphere(const glm::vec3& center, float radius, std::vector<int>& result) const {
+    QueryBox(center - glm::vec3(radius), center + glm::vec3(radius), result);
+}
+
+void SpatialHash::QuerySegment(const glm::vec3& start, const glm::vec3& end, float radius,
+                               std::vector<int>& result) const {
+    QueryBox(glm::min(start, end) - glm::vec3(radius), glm::max(start, end) + glm::vec3(radius), result);
+}
@@ -1,9 +1,10 @@
 #include "starfield.h"
-#include <cstdlib>
-#include <ctime>
+#include "geometry.h"
+#include "random.h"
+#include <cstddef>
 
-Starfield::Starfield(int num_stars) : star_count(num_stars) {
-    GenerateStars(num_stars);
+Starfield::Starfield(uint64_t run_seed, int num_stars) : star_count(num_stars) {
+    GenerateStars(run_seed, num_stars);
     InitializeBuffers();
 }
 
@@ -12,8 +13,8 @@ Starfield::~Starfield() {
     glDeleteVertexArrays(1, &vao);
 }
 
-void Starfield::GenerateStars(int num_stars) {
-    srand(static_cast<unsigned int>(time(nullptr)));
+void Starfield::GenerateStars(uint64_t run_seed, int num_stars) {
+    Random random(run_seed, RandomStream::STARFIELD);
 
     stars.clear();
     for (int i = 0; i < num_stars; i++) {
@@ -21,40 +22,42 @@ void Starfield::GenerateStars(int num_stars) {
 
         // Random positions in a large cube around the origin
         star.position = glm::vec3(
-            (rand() % 2000 - 1000) / 10.0f,  // -100 to 100
-            (rand() % 2000 - 1000) / 10.0f,
-            (rand() % 2000 - 1000) / 10.0f
+            random.NextInt(-1000, 999) / 10.0f,  // -100 to 100
+            random.NextInt(-1000, 999) / 10.0f,
+            random.NextInt(-1000, 999) / 10.0f
         );
 
         // Random brightness
-        star.brightness = 0.3f + (rand() % 700) / 1000.0f;  // 0.3 to 1.0
+        star.brightness = 0.3f + random.NextInt(0, 699) / 1000.0f;  // 0.3 to 1.0
 
         // Random size
-        star.size = 1.0f + (rand() % 200) / 100.0f;  // 1.0 to 3.0
+        star.size = 1.0f + random.NextInt(0, 199) / 100.0f;  // 1.0 to 3.0
 
         stars.push_back(star);
     }
 }
 
+// Per-star vertex: float position + brightness packed into the normal (16 bytes).
+// All stars are white, so color is a constant attribute set in Render().
+struct StarVertex {
+    GLfloat position[3];
+    GLuint normal;
+};
+
 void Starfield::InitializeBuffers() {
     // Create vertex data for point rendering
-    std::vector<float> vertex_data;
+    std::vector<StarVertex> vertex_data;
+    vertex_data.reserve(stars.size());
 
     for (const auto& star : stars) {
-        // Position (3 floats)
-        vertex_data.push_back(star.position.x);
-        vertex_data.push_back(star.position.y);
-        vertex_data.push_back(star.position.z);
-
-        // Normal (use as brightness - 3 floats)
-        vertex_data.push_back(star.brightness);
-        vertex_data.push_back(star.brightness);
-        vertex_data.push_back(star.brightness);
-
-        // Color (white - 3 floats)
-        vertex_data.push_back(1.0f);
-        vertex_data.push_back(1.0f);
-        vertex_data.push_back(1.0f);
+        StarVertex vertex;
+        vertex.position[0] = star.position.x;
+        vertex.position[1] = star.position.y;
+        vertex.position[2] = star.position.z;
+
+        // Normal (use as brightness)
+        vertex.normal = PackSnorm1010102(glm::vec3(star.brightness));
+        vertex_data.push_back(vertex);
     }
 
     // Create VAO and VBO
@@ -63,19 +66,17 @@ void Starfield::InitializeBuffers() {
 
     glBindVertexArray(vao);
     glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER, vertex_data.size() * sizeof(float), vertex_data.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertex_data.size() * sizeof(StarVertex), vertex_data.data(), GL_STATIC_DRAW);
 
     // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(VERTEX_ATTRIB_LOCATION, 3, GL_FLOAT, GL_FALSE, sizeof(StarVertex),
+                          (void*)offsetof(StarVertex, position));
+    glEnableVertexAttribArray(VERTEX_ATTRIB_LOCATION);
 
     // Normal attribute (location 1) - used for brightness
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-
-    // Color attribute (location 2)
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(NORMAL_ATTRIB_LOCATION, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(StarVertex),
+                          (void*)offsetof(StarVertex, normal));
+    glEnableVertexAttribArray(NORMAL_ATTRIB_LOCATION);
 
     glBindVertexArray(0);
 }
@@ -89,6 +90,7 @@ void Starfield::Render(GLuint shader_program) {
     glDepthMask(GL_FALSE);
 
     glBindVertexArray(vao);
+    glVertexAttrib3f(COLOR_ATTRIB_LOCATION, 1.0f, 1.0f, 1.0f);
     glDrawArrays(GL_POINTS, 0, star_count);
     glBindVertexArray(0);
 
@@ -0,0 +1,102 @@
+#include "systems.h"
+#include "scene_node.h"
+
+void UpdateShip(ShipMotion& motion, Transform& transform, float delta_time) {
+    // Calculate desired velocity based on input
+    glm::vec3 desired_velocity(0.0f);
+
+    // Get ship's forward and right directions
+    glm::vec3 forward = QuatForward(transform.orientation);
+    glm::vec3 right = glm::mat3_cast(transform.orientation)[0];
+
+    if (motion.moving_forward) desired_velocity += forward * motion.max_speed;
+    if (motion.moving_backward) desired_velocity -= forward * motion.max_speed * 0.5f;
+    if (motion.moving_left) desired_velocity -= right * motion.max_speed * 0.7f;
+    if (motion.moving_right) desired_velocity += right * motion.max_speed * 0.7f;
+
+    // Smooth acceleration/deceleration
+    if (glm::length(desired_velocity) > 0.001f) {
+        // Accelerate towards desired velocity
+        glm::vec3 velocity_diff = desired_velocity - motion.velocity;
+        float diff_length = glm::length(velocity_diff);
+        if (diff_length > 0.001f) {
+            motion.acceleration = glm::normalize(velocity_diff) * motion.acceleration_rate;
+        }
+    } else {
+        // Decelerate to stop
+        if (glm::length(motion.velocity) > 0.001f) {
+            motion.acceleration = -glm::normalize(motion.velocity) * motion.deceleration_rate;
+        } else {
+            motion.velocity = glm::vec3(0.0f);
+            motion.acceleration = glm::vec3(0.0f);
+        }
+    }
+
+    // Update velocity, clamped to max speed
+    motion.velocity += motion.acceleration * delta_time;
+    float speed = glm::length(motion.velocity);
+    if (speed > motion.max_speed) {
+        motion.velocity = glm::normalize(motion.velocity) * motion.max_speed;
+    }
+
+    transform.position += motion.velocity * delta_time;
+}
+
+void FireProjectile(ProjectileComponents& projectiles, size_t row, const glm::vec3& position,
+                    const glm::quat& orientation) {
+    projectiles.positions[row] = position;
+    projectiles.orientations[row] = orientation;
+    // Flight direction is fixed at launch; spinning about the flight axis does not change it
+    projectiles.velocities[row].linear = QuatForward(orientation) * projectiles.speed;
+    projectiles.lifetimes[row].age = 0.0f;
+    projectiles.lifetimes[row].max_age = projectiles.max_lifetime;
+    projectiles.active[row] = 1;
+}
+
+bool AdvanceProjectile(ProjectileComponents& projectiles, size_t row, float delta_time) {
+    if (!projectiles.active[row]) return false;
+
+    Lifetime& lifetime = projectiles.lifetimes[row];
+    lifetime.age += delta_time;
+    if (lifetime.age >= lifetime.max_age) {
+        projectiles.active[row] = 0;
+        return false;
+    }
+
+    projectiles.positions[row] += projectiles.velocities[row].linear * delta_time;
+    if (projectiles.spin_rate != 0.0f) {
+        glm::quat rotation = glm::angleAxis(delta_time * projectiles.spin_rate, glm::vec3(0.0f, 0.0f, 1.0f));
+        projectiles.orientations[row] = projectiles.orientations[row] * rotation;
+    }
+    return true;
+}
+
+void SpinAsteroids(AsteroidComponents& asteroids, const glm::quat& rotation, SimdLevel level, size_t begin,
+                   size_t end) {
+    glm::quat* orientations = asteroids.orientations.data() + begin;
+    MultiplyQuatsBatch(level, orientations, rotation, orientations, end - begin);
+}
+
+void SyncAsteroidNodes(const AsteroidComponents& asteroids, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+        SceneNode* node = asteroids.nodes[i];
+        bool visible = asteroids.live[i] != 0;
+        node->SetVisible(visible);
+        if (visible) {
+            node->SetPosition(asteroids.positions[i]);
+            node->SetOrientation(asteroids.orientations[i]);
+        }
+    }
+}
+
+void SyncProjectileNodes(const ProjectileComponents& projectiles) {
+    for (size_t i = 0; i < projectiles.GetCount(); i++) {
+        SceneNode* node = projectiles.nodes[i];
+        bool visible = projectiles.active[i] != 0;
+        node->SetVisible(visible);
+        if (visible) {
+            node->SetPosition(projectiles.positions[i]);
+            node->SetOrientation(projectiles.orientations[i]);
+        }
+    }
+}
@@ -0,0 +1,290 @@
+#include "transform_simd.h"
+
+// The SSE2 kernels load quaternions as 4 floats in glm's default x, y, z, w order
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && \
+    !defined(GLM_FORCE_QUAT_DATA_WXYZ)
+#define TRANSFORM_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+
+static_assert(sizeof(glm::quat) == 4 * sizeof(float), "quaternions must be packed");
+static_assert(sizeof(glm::mat4) == 16 * sizeof(float), "matrices must be packed");
+
+glm::vec3 QuatForward(const glm::quat& orientation) {
+    // Third column of mat4_cast(orientation), negated
+    float qxx = orientation.x * orientation.x;
+    float qyy = orientation.y * orientation.y;
+    float qxz = orientation.x * orientation.z;
+    float qyz = orientation.y * orientation.z;
+    float qwx = orientation.w * orientation.x;
+    float qwy = orientation.w * orientation.y;
+    return glm::vec3(-2.0f * (qxz + qwy), -2.0f * (qyz - qwx), 2.0f * (qxx + qyy) - 1.0f);
+}
+
+glm::mat4 ComposeTrs(const glm::vec3& position, const glm::quat& orientation, const glm::vec3& scale) {
+    float qxx = orientation.x * orientation.x;
+    float qyy = orientation.y * orientation.y;
+    float qzz = orientation.z * orientation.z;
+    float qxy = orientation.x * orientation.y;
+    float qxz = orientation.x * orientation.z;
+    float qyz = orientation.y * orientation.z;
+    float qwx = orientation.w * orientation.x;
+    float qwy = orientation.w * orientation.y;
+    float qwz = orientation.w * orientation.z;
+
+    glm::mat4 result;
+    result[0] = glm::vec4((1.0f - 2.0f * (qyy + qzz)) * scale.x, 2.0f * (qxy + qwz) * scale.x,
+                          2.0f * (qxz - qwy) * scale.x, 0.0f);
+    result[1] = glm::vec4(2.0f * (qxy - qwz) * scale.y, (1.0f - 2.0f * (qxx + qzz)) * scale.y,
+                          2.0f * (qyz + qwx) * scale.y, 0.0f);
+    result[2] = glm::vec4(2.0f * (qxz + qwy) * scale.z, 2.0f * (qyz - qwx) * scale.z,
+                          (1.0f - 2.0f * (qxx + qyy)) * scale.z, 0.0f);
+    result[3] = glm::vec4(position, 1.0f);
+    return result;
+}
+
+glm::mat4 AffineNormalMatrix(const glm::mat4& world) {
+    glm::vec3 a(world[0]);
+    glm::vec3 b(world[1]);
+    glm::vec3 c(world[2]);
+
+    // The rows of the inverse are the cross products of the columns over the
+    // determinant, so they are the columns of the inverse-transpose
+    glm::vec3 bc = glm::cross(b, c);
+    glm::vec3 ca = glm::cross(c, a);
+    glm::vec3 ab = glm::cross(a, b);
+    float inv_det = 1.0f / glm::dot(a, bc);
+
+    glm::mat4 result;
+    result[0] = glm::vec4(bc * inv_det, 0.0f);
+    result[1] = glm::vec4(ca * inv_det, 0.0f);
+    result[2] = glm::vec4(ab * inv_det, 0.0f);
+    result[3] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    return result;
+}
+
+#ifdef TRANSFORM_SIMD_SSE2
+
+// Load 4 quaternions and transpose them to x, y, z and w of each in a lane
+static void LoadQuats(const glm::quat* quats, __m128& x, __m128& y, __m128& z, __m128& w) {
+    x = _mm_loadu_ps(&quats[0].x);
+    y = _mm_loadu_ps(&quats[1].x);
+    z = _mm_loadu_ps(&quats[2].x);
+    w = _mm_loadu_ps(&quats[3].x);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+}
+
+static void LoadVec3s(const glm::vec3* vectors, __m128& x, __m128& y, __m128& z) {
+    x = _mm_setr_ps(vectors[0].x, vectors[1].x, vectors[2].x, vectors[3].x);
+    y = _mm_setr_ps(vectors[0].y, vectors[1].y, vectors[2].y, vectors[3].y);
+    z = _mm_setr_ps(vectors[0].z, vectors[1].z, vectors[2].z, vectors[3].z);
+}
+
+// Transpose lanes back to 4 columns and store column `column` of 4 matrices
+static void StoreColumns(glm::mat4* matrices, int column, __m128 x, __m128 y, __m128 z, __m128 w) {
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    _mm_storeu_ps(&matrices[0][column][0], x);
+    _mm_storeu_ps(&matrices[1][column][0], y);
+    _mm_storeu_ps(&matrices[2][column][0], z);
+    _mm_storeu_ps(&matrices[3][column][0], w);
+}
+
+static void StoreVec3(glm::vec3& vector, __m128 value) {
+    _mm_storel_pi(reinterpret_cast<__m64*>(&vector.x), value);
+    _mm_store_ss(&vector.z, _mm_movehl_ps(value, value));
+}
+
+// Each kernel handles whole groups of 4 and returns how many it did
+
+static size_t MultiplyQuatsSse2(const glm::quat* quats, const glm::quat& rotation, glm::quat* out, size_t count) {
+    const __m128 rx = _mm_set1_ps(rotation.x);
+    const __m128 ry = _mm_set1_ps(rotation.y);
+    const __m128 rz = _mm_set1_ps(rotation.z);
+    const __m128 rw = _mm_set1_ps(rotation.w);
+
+    size_t done = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < done; i += 4) {
+        __m128 x, y, z, w;
+        LoadQuats(quats + i, x, y, z, w);
+
+        __m128 ow = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(w, rw), _mm_mul_ps(x, rx)), _mm_mul_ps(y, ry)),
+                               _mm_mul_ps(z, rz));
+        __m128 ox = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, rx), _mm_mul_ps(x, rw)), _mm_mul_ps(y, rz)),
+                               _mm_mul_ps(z, ry));
+        __m128 oy = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, ry), _mm_mul_ps(y, rw)), _mm_mul_ps(z, rx)),
+                               _mm_mul_ps(x, rz));
+        __m128 oz = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(w, rz), _mm_mul_ps(z, rw)), _mm_mul_ps(x, ry)),
+                               _mm_mul_ps(y, rx));
+
+        _MM_TRANSPOSE4_PS(ox, oy, oz, ow);
+        _mm_storeu_ps(&out[i].x, ox);
+        _mm_storeu_ps(&out[i + 1].x, oy);
+        _mm_storeu_ps(&out[i + 2].x, oz);
+        _mm_storeu_ps(&out[i + 3].x, ow);
+    }
+    return done;
+}
+
+static size_t QuatForwardSse2(const glm::quat* quats, glm::vec3* forward, size_t count) {
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 minus_two = _mm_set1_ps(-2.0f);
+
+    size_t done = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < done; i += 4) {
+        __m128 x, y, z, w;
+        LoadQuats(quats + i, x, y, z, w);
+
+        __m128 fx = _mm_mul_ps(minus_two, _mm_add_ps(_mm_mul_ps(x, z), _mm_mul_ps(w, y)));
+        __m128 fy = _mm_mul_ps(minus_two, _mm_sub_ps(_mm_mul_ps(y, z), _mm_mul_ps(w, x)));
+        __m128 fz = _mm_sub_ps(_mm_mul_ps(two, _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y))), one);
+        __m128 unused = _mm_setzero_ps();
+
+        _MM_TRANSPOSE4_PS(fx, fy, fz, unused);
+        StoreVec3(forward[i], fx);
+        StoreVec3(forward[i + 1], fy);
+        StoreVec3(forward[i + 2], fz);
+        StoreVec3(forward[i + 3], unused);
+    }
+    return done;
+}
+
+static size_t ComposeTrsSse2(const glm::vec3* positions, const glm::quat* orientations, const glm::vec3* scales,
+                             glm::mat4* out, size_t count) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+
+    size_t done = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < done; i += 4) {
+        __m128 x, y, z, w;
+        LoadQuats(orientations + i, x, y, z, w);
+        __m128 sx, sy, sz;
+        LoadVec3s(scales + i, sx, sy, sz);
+
+        __m128 qxx = _mm_mul_ps(x, x);
+        __m128 qyy = _mm_mul_ps(y, y);
+        __m128 qzz = _mm_mul_ps(z, z);
+        __m128 qxy = _mm_mul_ps(x, y);
+        __m128 qxz = _mm_mul_ps(x, z);
+        __m128 qyz = _mm_mul_ps(y, z);
+        __m128 qwx = _mm_mul_ps(w, x);
+        __m128 qwy = _mm_mul_ps(w, y);
+        __m128 qwz = _mm_mul_ps(w, z);
+
+        StoreColumns(out + i, 0,
+                     _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qyy, qzz))), sx),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(qxy, qwz)), sx),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(qxz, qwy)), sx), zero);
+        StoreColumns(out + i, 1,
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(qxy, qwz)), sy),
+                     _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qxx, qzz))), sy),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(qyz, qwx)), sy), zero);
+        StoreColumns(out + i, 2,
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(qxz, qwy)), sz),
+                     _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(qyz, qwx)), sz),
+                     _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qxx, qyy))), sz), zero);
+
+        __m128 px, py, pz;
+        LoadVec3s(positions + i, px, py, pz);
+        StoreColumns(out + i, 3, px, py, pz, one);
+    }
+    return done;
+}
+
+static size_t AffineNormalMatrixSse2(const glm::mat4* world, glm::mat4* normal, size_t count) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 translation = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+
+    size_t done = count & ~static_cast<size_t>(3);
+    for (size_t i = 0; i < done; i += 4) {
+        // Columns a, b and c of the upper 3x3, one matrix per lane
+        __m128 ax = _mm_loadu_ps(&world[i][0][0]);
+        __m128 ay = _mm_loadu_ps(&world[i + 1][0][0]);
+        __m128 az = _mm_loadu_ps(&world[i + 2][0][0]);
+        __m128 aw = _mm_loadu_ps(&world[i + 3][0][0]);
+        _MM_TRANSPOSE4_PS(ax, ay, az, aw);
+        __m128 bx = _mm_loadu_ps(&world[i][1][0]);
+        __m128 by = _mm_loadu_ps(&world[i + 1][1][0]);
+        __m128 bz = _mm_loadu_ps(&world[i + 2][1][0]);
+        __m128 bw = _mm_loadu_ps(&world[i + 3][1][0]);
+        _MM_TRANSPOSE4_PS(bx, by, bz, bw);
+        __m128 cx = _mm_loadu_ps(&world[i][2][0]);
+        __m128 cy = _mm_loadu_ps(&world[i + 1][2][0]);
+        __m128 cz = _mm_loadu_ps(&world[i + 2][2][0]);
+        __m128 cw = _mm_loadu_ps(&world[i + 3][2][0]);
+        _MM_TRANSPOSE4_PS(cx, cy, cz, cw);
+
+        __m128 bc_x = _mm_sub_ps(_mm_mul_ps(by, cz), _mm_mul_ps(bz, cy));
+        __m128 bc_y = _mm_sub_ps(_mm_mul_ps(bz, cx), _mm_mul_ps(bx, cz));
+        __m128 bc_z = _mm_sub_ps(_mm_mul_ps(bx, cy), _mm_mul_ps(by, cx));
+        __m128 ca_x = _mm_sub_ps(_mm_mul_ps(cy, az), _mm_mul_ps(cz, ay));
+        __m128 ca_y = _mm_sub_ps(_mm_mul_ps(cz, ax), _mm_mul_ps(cx, az));
+        __m128 ca_z = _mm_sub_ps(_mm_mul_ps(cx, ay), _mm_mul_ps(cy, ax));
+        __m128 ab_x = _mm_sub_ps(_mm_mul_ps(ay, bz), _mm_mul_ps(az, by));
+        __m128 ab_y = _mm_sub_ps(_mm_mul_ps(az, bx), _mm_mul_ps(ax, bz));
+        __m128 ab_z = _mm_sub_ps(_mm_mul_ps(ax, by), _mm_mul_ps(ay, bx));
+
+        __m128 det = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bc_x), _mm_mul_ps(ay, bc_y)), _mm_mul_ps(az, bc_z));
+        __m128 inv_det = _mm_div_ps(one, det);
+
+        // Every column of the world matrices is loaded, so normal may alias world
+        StoreColumns(normal + i, 0, _mm_mul_ps(bc_x, inv_det), _mm_mul_ps(bc_y, inv_det),
+                     _mm_mul_ps(bc_z, inv_det), zero);
+        StoreColumns(normal + i, 1, _mm_mul_ps(ca_x, inv_det), _mm_mul_ps(ca_y, inv_det),
+                     _mm_mul_ps(ca_z, inv_det), zero);
+        StoreColumns(normal + i, 2, _mm_mul_ps(ab_x, inv_det), _mm_mul_ps(ab_y, inv_det),
+                     _mm_mul_ps(ab_z, inv_det), zero);
+        for (size_t k = 0; k < 4; k++) {
+            _mm_storeu_ps(&normal[i + k][3][0], translation);
+        }
+    }
+    return done;
+}
+
+#endif // TRANSFORM_SIMD_SSE2
+
+// SSE2 also serves the AVX2 level; the scalar loops finish any remainder
+
+void MultiplyQuatsBatch(SimdLevel level, const glm::quat* quats, const glm::quat& rotation, glm::quat* out,
+                        size_t count) {
+    size_t i = 0;
+#ifdef TRANSFORM_SIMD_SSE2
+    if (level != SimdLevel::SCALAR) i = MultiplyQuatsSse2(quats, rotation, out, count);
+#endif
+    for (; i < count; i++) {
+        out[i] = quats[i] * rotation;
+    }
+}
+
+void QuatForwardBatch(SimdLevel level, const glm::quat* quats, glm::vec3* forward, size_t count) {
+    size_t i = 0;
+#ifdef TRANSFORM_SIMD_SSE2
+    if (level != SimdLevel::SCALAR) i = QuatForwardSse2(quats, forward, count);
+#endif
+    for (; i < count; i++) {
+        forward[i] = QuatForward(quats[i]);
+    }
+}
+
+void ComposeTrsBatch(SimdLevel level, const glm::vec3* positions, const glm::quat* orientations,
+                     const glm::vec3* scales, glm::mat4* out, size_t count) {
+    size_t i = 0;
+#ifdef TRANSFORM_SIMD_SSE2
+    if (level != SimdLevel::SCALAR) i = ComposeTrsSse2(positions, orientations, scales, out, count);
+#endif
+    for (; i < count; i++) {
+        out[i] = ComposeTrs(positions[i], orientations[i], scales[i]);
+    }
+}
+
+void AffineNormalMatrixBatch(SimdLevel level, const glm::mat4* world, glm::mat4* normal, size_t count) {
+    size_t i = 0;
+#ifdef TRANSFORM_SIMD_SSE2
+    if (level != SimdLevel::SCALAR) i = AffineNormalMatrixSse2(world, normal, count);
+#endif
+    for (; i < count; i++) {
+        normal[i] = AffineNormalMatrix(world[i]);
+    }
+}
@@ -1,5 +1,6 @@
 #include "ui/button.h"
 #include "ui/text_renderer.h"
+#include "shader_program.h"
 #include <iostream>
 #include <functional>
 
@@ -86,16 +87,16 @@ void Button::Execute() {
     }
 }
 
-void Button::RenderQuad(GLuint shader_program, const glm::vec3& color) {
-    glUseProgram(shader_program);
-    glUniform3f(glGetUniformLocation(shader_program, "color"), color.x, color.y, color.z);
+void Button::RenderQuad(const ShaderProgram* shader_program, const glm::vec3& color) {
+    shader_program->Use();
+    glUniform3f(shader_program->GetUniform(UniformSlot::COLOR), color.x, color.y, color.z);
 
     glBindVertexArray(VAO_);
     glDrawArrays(GL_TRIANGLES, 0, 6);
     glBindVertexArray(0);
 }
 
-void Button::Render(TextRenderer* text_renderer, GLuint shader_program) {
+void Button::Render(TextRenderer* text_renderer, const ShaderProgram* shader_program) {
     if (!text_renderer) return;
 
     // Determine button color based on state
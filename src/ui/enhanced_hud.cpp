@@ -1,5 +1,7 @@
 #include "ui/enhanced_hud.h"
 #include "ui/text_renderer.h"
+#include "shader_program.h"
+#include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
@@ -11,10 +13,8 @@ const char* BAR_VERTEX_SHADER = R"(
 #version 330 core
 layout (location = 0) in vec2 position;
 
-uniform mat4 projection;
-
 void main() {
-    gl_Position = projection * vec4(position, 0.0, 1.0);
+    gl_Position = frame.ui_projection * vec4(position, 0.0, 1.0);
 }
 )";
 
@@ -34,39 +34,28 @@ EnhancedHUD::EnhancedHUD(int window_width, int window_height)
       text_renderer_(nullptr), health_(100), max_health_(100),
       score_(0), wave_(1), combo_multiplier_(1),
       laser_ammo_(999), missile_ammo_(999), game_time_(0.0f),
-      damage_flash_timer_(0.0f), low_health_pulse_(0.0f),
-      bar_VAO_(0), bar_VBO_(0), bar_shader_program_(0) {
+      damage_flash_timer_(0.0f), low_health_pulse_(0.0f), show_debug_info_(false),
+      bar_VAO_(0), bar_VBO_(0), bar_color_loc_(-1) {
 }
 
 EnhancedHUD::~EnhancedHUD() {
     if (bar_VAO_) glDeleteVertexArrays(1, &bar_VAO_);
     if (bar_VBO_) glDeleteBuffers(1, &bar_VBO_);
-    if (bar_shader_program_) glDeleteProgram(bar_shader_program_);
 }
 
 bool EnhancedHUD::Initialize(TextRenderer* text_renderer) {
     text_renderer_ = text_renderer;
-    InitializeBarRendering();
-    return true;
+    return InitializeBarRendering();
 }
 
-void EnhancedHUD::InitializeBarRendering() {
+bool EnhancedHUD::InitializeBarRendering() {
     // Create shader program for rendering bars
-    GLuint vs = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vs, 1, &BAR_VERTEX_SHADER, NULL);
-    glCompileShader(vs);
-
-    GLuint fs = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fs, 1, &BAR_FRAGMENT_SHADER, NULL);
-    glCompileShader(fs);
-
-    bar_shader_program_ = glCreateProgram();
-    glAttachShader(bar_shader_program_, vs);
-    glAttachShader(bar_shader_program_, fs);
-    glLinkProgram(bar_shader_program_);
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
+    bar_shader_program_ = std::make_unique<ShaderProgram>();
+    if (!bar_shader_program_->Load(BAR_VERTEX_SHADER, BAR_FRAGMENT_SHADER)) {
+        std::cerr << "Failed to load HUD bar shaders: " << bar_shader_program_->GetLog() << std::endl;
+        return false;
+    }
+    bar_color_loc_ = bar_shader_program_->GetUniform(UniformSlot::COLOR);
 
     // Create VAO and VBO for rendering quads
     glGenVertexArrays(1, &bar_VAO_);
@@ -82,6 +71,7 @@ void EnhancedHUD::InitializeBarRendering() {
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
     glUseProgram(0);  // Reset shader program to avoid interference
+    return true;
 }
 
 void EnhancedHUD::ShowScorePopup(int score, float x, float y) {
@@ -132,6 +122,7 @@ void EnhancedHUD::Render() {
     RenderCrosshair();
     RenderScorePopups();
     RenderDamageFlash();
+    RenderDebugInfo();
 
     glDisable(GL_BLEND);
 }
@@ -271,6 +262,17 @@ void EnhancedHUD::RenderDamageFlash() {
     }
 }
 
+void EnhancedHUD::RenderDebugInfo() {
+    if (!show_debug_info_) return;
+
+    float x = 20.0f;
+    float y = window_height_ - 180.0f;
+    for (const auto& line : debug_lines_) {
+        text_renderer_->RenderText(line, x, y, 0.6f, glm::vec3(0.6f, 1.0f, 0.6f));
+        y -= 20.0f;
+    }
+}
+
 void EnhancedHUD::RenderBar(float x, float y, float width, float height,
                              float fill_percentage, const glm::vec3& color) {
     float fill_width = width * fill_percentage;
@@ -285,17 +287,10 @@ void EnhancedHUD::RenderBar(float x, float y, float width, float height,
         x, y + height
     };
 
-    glUseProgram(bar_shader_program_);
-
-    // Set projection matrix
-    glm::mat4 projection = glm::ortho(0.0f, static_cast<float>(window_width_),
-                                      0.0f, static_cast<float>(window_height_));
-    glUniformMatrix4fv(glGetUniformLocation(bar_shader_program_, "projection"),
-                       1, GL_FALSE, &projection[0][0]);
+    bar_shader_program_->Use();
 
     // Set color
-    glUniform3f(glGetUniformLocation(bar_shader_program_, "color"),
-                color.x, color.y, color.z);
+    glUniform3f(bar_color_loc_, color.x, color.y, color.z);
 
     glBindVertexArray(bar_VAO_);
     glBindBuffer(GL_ARRAY_BUFFER, bar_VBO_);
@@ -1,6 +1,7 @@
 #include "ui/menu_manager.h"
 #include "ui/button.h"
 #include "ui/text_renderer.h"
+#include "shader_program.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
@@ -13,10 +14,8 @@ const char* UI_VERTEX_SHADER = R"(
 #version 330 core
 layout (location = 0) in vec2 position;
 
-uniform mat4 projection;
-
 void main() {
-    gl_Position = projection * vec4(position, 0.0, 1.0);
+    gl_Position = frame.ui_projection * vec4(position, 0.0, 1.0);
 }
 )";
 
@@ -37,10 +36,8 @@ const char* TEXT_VERTEX_SHADER = R"(
 layout (location = 0) in vec4 vertex;
 out vec2 TexCoords;
 
-uniform mat4 projection;
-
 void main() {
-    gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
+    gl_Position = frame.ui_projection * vec4(vertex.xy, 0.0, 1.0);
     TexCoords = vertex.zw;
 }
 )";
@@ -62,47 +59,34 @@ void main() {
 MenuManager::MenuManager(int window_width, int window_height)
     : window_width_(window_width), window_height_(window_height),
       current_menu_(MenuState::MAIN_MENU),
-      text_shader_program_(0), ui_shader_program_(0),
       game_over_score_(0), game_over_wave_(0) {
 }
 
 MenuManager::~MenuManager() {
-    if (text_shader_program_) glDeleteProgram(text_shader_program_);
-    if (ui_shader_program_) glDeleteProgram(ui_shader_program_);
 }
 
 bool MenuManager::Initialize() {
     // Load UI shaders for button quads
-    ui_shader_program_ = LoadShaders(UI_VERTEX_SHADER, UI_FRAGMENT_SHADER);
-    if (ui_shader_program_ == 0) {
-        std::cerr << "Failed to load UI shaders" << std::endl;
+    ui_shader_program_ = std::make_unique<ShaderProgram>();
+    if (!ui_shader_program_->Load(UI_VERTEX_SHADER, UI_FRAGMENT_SHADER)) {
+        std::cerr << "Failed to load UI shaders: " << ui_shader_program_->GetLog() << std::endl;
         return false;
     }
 
-    // Set projection matrix for UI shader (orthographic, screen coordinates)
-    glm::mat4 ui_projection = glm::ortho(0.0f, (float)window_width_, 0.0f, (float)window_height_);
-    glUseProgram(ui_shader_program_);
-    glUniformMatrix4fv(glGetUniformLocation(ui_shader_program_, "projection"), 1, GL_FALSE, &ui_projection[0][0]);
-
     // Load text shaders
-    text_shader_program_ = LoadShaders(TEXT_VERTEX_SHADER, TEXT_FRAGMENT_SHADER);
-    if (text_shader_program_ == 0) {
-        std::cerr << "Failed to load text shaders" << std::endl;
+    text_shader_program_ = std::make_unique<ShaderProgram>();
+    if (!text_shader_program_->Load(TEXT_VERTEX_SHADER, TEXT_FRAGMENT_SHADER)) {
+        std::cerr << "Failed to load text shaders: " << text_shader_program_->GetLog() << std::endl;
         return false;
     }
 
     // Initialize text renderer
     text_renderer_ = std::make_unique<TextRenderer>();
-    if (!text_renderer_->Initialize(text_shader_program_)) {
+    if (!text_renderer_->Initialize(text_shader_program_.get())) {
         std::cerr << "Failed to initialize text renderer" << std::endl;
         return false;
     }
 
-    // Set orthographic projection for text rendering
-    glm::mat4 text_projection = glm::ortho(0.0f, static_cast<float>(window_width_),
-                                           0.0f, static_cast<float>(window_height_));
-    text_renderer_->SetProjection(text_projection);
-
     // Create button layouts for all menus
     CreateMainMenuButtons();
     CreatePauseMenuButtons();
@@ -338,7 +322,7 @@ void MenuManager::RenderMainMenu() {
 
     // Render buttons (using UI shader for quads)
     for (auto& btn : main_menu_buttons_) {
-        btn->Render(text_renderer_.get(), ui_shader_program_);
+        btn->Render(text_renderer_.get(), ui_shader_program_.get());
     }
 }
 
@@ -352,7 +336,7 @@ void MenuManager::RenderPauseMenu() {
 
     // Render buttons
     for (auto& btn : pause_menu_buttons_) {
-        btn->Render(text_renderer_.get(), ui_shader_program_);
+        btn->Render(text_renderer_.get(), ui_shader_program_.get());
     }
 }
 
@@ -381,7 +365,7 @@ void MenuManager::RenderGameOverScreen() {
 
     // Render buttons
     for (auto& btn : game_over_buttons_) {
-        btn->Render(text_renderer_.get(), ui_shader_program_);
+        btn->Render(text_renderer_.get(), ui_shader_program_.get());
     }
 }
 
@@ -430,53 +414,6 @@ void MenuManager::RenderSettings() {
 
     // Render back button
     for (auto& btn : settings_buttons_) {
-        btn->Render(text_renderer_.get(), ui_shader_program_);
-    }
-}
-
-GLuint MenuManager::CompileShader(const char* source, GLenum shader_type) {
-    GLuint shader = glCreateShader(shader_type);
-    glShaderSource(shader, 1, &source, NULL);
-    glCompileShader(shader);
-
-    // Check for compilation errors
-    GLint success;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        char info_log[512];
-        glGetShaderInfoLog(shader, 512, NULL, info_log);
-        std::cerr << "Shader compilation failed: " << info_log << std::endl;
-        return 0;
-    }
-
-    return shader;
-}
-
-GLuint MenuManager::LoadShaders(const char* vertex_shader, const char* fragment_shader) {
-    GLuint vs = CompileShader(vertex_shader, GL_VERTEX_SHADER);
-    GLuint fs = CompileShader(fragment_shader, GL_FRAGMENT_SHADER);
-
-    if (vs == 0 || fs == 0) {
-        return 0;
+        btn->Render(text_renderer_.get(), ui_shader_program_.get());
     }
-
-    GLuint program = glCreateProgram();
-    glAttachShader(program, vs);
-    glAttachShader(program, fs);
-    glLinkProgram(program);
-
-    // Check for linking errors
-    GLint success;
-    glGetProgramiv(program, GL_LINK_STATUS, &success);
-    if (!success) {
-        char info_log[512];
-        glGetProgramInfoLog(program, 512, NULL, info_log);
-        std::cerr << "Shader linking failed: " << info_log << std::endl;
-        return 0;
-    }
-
-    glDeleteShader(vs);
-    glDeleteShader(fs);
-
-    return program;
 }
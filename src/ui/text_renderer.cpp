@@ -1,5 +1,6 @@
 #define GLEW_NO_GLU
 #include "ui/text_renderer.h"
+#include "shader_program.h"
 #include <iostream>
 #include <cstring>
 
@@ -103,7 +104,8 @@ static const unsigned char font_8x8[95][8] = {
     {0x6E,0x3B,0x00,0x00,0x00,0x00,0x00,0x00}, // ~
 };
 
-TextRenderer::TextRenderer() : VAO(0), VBO(0), shader_program_(0) {
+TextRenderer::TextRenderer()
+    : VAO(0), VBO(0), shader_program_(nullptr), text_color_loc_(-1) {
 }
 
 TextRenderer::~TextRenderer() {
@@ -111,8 +113,9 @@ TextRenderer::~TextRenderer() {
     if (VBO) glDeleteBuffers(1, &VBO);
 }
 
-bool TextRenderer::Initialize(GLuint shader_program) {
+bool TextRenderer::Initialize(const ShaderProgram* shader_program) {
     shader_program_ = shader_program;
+    text_color_loc_ = shader_program->GetUniform(UniformSlot::TEXT_COLOR);
 
     // Configure VAO/VBO for texture quads
     glGenVertexArrays(1, &VAO);
@@ -201,10 +204,6 @@ void TextRenderer::CreateSimpleFontAtlas() {
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
-void TextRenderer::SetProjection(const glm::mat4& projection) {
-    projection_ = projection;
-}
-
 void TextRenderer::RenderText(const std::string& text, float x, float y,
                                float scale, const glm::vec3& color) {
     // Save OpenGL state
@@ -219,11 +218,8 @@ void TextRenderer::RenderText(const std::string& text, float x, float y,
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Activate shader and set uniforms
-    glUseProgram(shader_program_);
-    glUniform3f(glGetUniformLocation(shader_program_, "textColor"),
-                color.x, color.y, color.z);
-    glUniformMatrix4fv(glGetUniformLocation(shader_program_, "projection"),
-                       1, GL_FALSE, &projection_[0][0]);
+    shader_program_->Use();
+    glUniform3f(text_color_loc_, color.x, color.y, color.z);
     glActiveTexture(GL_TEXTURE0);
     glBindVertexArray(VAO);
 
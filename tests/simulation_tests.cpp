@@ -0,0 +1,93 @@
+/* AsteroidPatrolTests - correctness checks for the simulation library.
+ *
+ * Each check builds what it needs, runs it and throws on the first wrong
+ * result. Registered with CTest, so `ctest` runs them after a build; the
+ * program exits with -1 and names the failing check otherwise.
+ *
+ * Usage: AsteroidPatrolTests
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include "simulation.h"
+#include "slot_map.h"
+#include "job_system.h"
+
+static void Check(bool condition, const std::string& message) {
+    if (!condition) {
+        throw(std::runtime_error(message));
+    }
+}
+
+// Removing an entry and inserting into its slot again must change the
+// generation, so the old handle stops resolving
+static void TestSlotMapReuse() {
+    SlotMap<int> map;
+    EntityHandle first = map.Insert(1);
+    Check(map.Remove(first), "Remove() rejected a live handle");
+    EntityHandle second = map.Insert(2);
+    Check(second.index == first.index, "Insert() did not reuse the free slot");
+    Check(second != first, "Reused slot returned the same handle");
+    Check(map.Get(first) == nullptr, "Stale handle still resolves");
+    Check(map.Get(second) && *map.Get(second) == 2, "New handle does not resolve to the new value");
+}
+
+// A shot fired from a pool slot that held an earlier one, whether that one
+// expired or was recycled in flight, gets a handle of its own and leaves
+// the earlier handle stale
+static void TestRefiredProjectileHandles() {
+    GameManager game;
+    JobSystem jobs(1);
+    Simulation simulation(&game, &jobs, 1);
+    simulation.laser_capacity = 1;
+    simulation.CreateWorld(15);
+    game.StartGame();
+
+    EntityHandle expired = simulation.FireLaser();
+    Check(!expired.IsNull() && simulation.GetPosition(expired), "Fired laser has no live handle");
+    float step = 1.0f / 60.0f;
+    for (float time = 0.0f; simulation.lasers.active[0] && time < 2.0f * simulation.lasers.max_lifetime; time += step) {
+        simulation.Step(step);
+    }
+    Check(!simulation.lasers.active[0], "Laser never left flight");
+
+    EntityHandle refired = simulation.FireLaser();
+    Check(!refired.IsNull() && simulation.GetPosition(refired), "Refired laser has no live handle");
+    Check(refired != expired, "Refired laser got the handle of the expired one");
+    Check(simulation.GetPosition(expired) == nullptr, "Handle of an expired laser still resolves");
+
+    // The only slot is in flight, so the default policy recycles it
+    EntityHandle recycled = simulation.FireLaser();
+    Check(!recycled.IsNull() && simulation.GetPosition(recycled), "Recycled laser has no live handle");
+    Check(recycled != refired, "Recycled laser got the handle of the one in flight");
+    Check(simulation.GetPosition(refired) == nullptr, "Handle of a recycled laser still resolves");
+
+    simulation.laser_pool.overflow = PoolOverflow::REJECT;
+    Check(simulation.FireLaser().IsNull(), "Rejected shot returned a handle");
+    Check(simulation.GetPosition(recycled) != nullptr, "Rejected shot retired the laser in flight");
+}
+
+int main() {
+    struct Test {
+        const char* name;
+        void (*function)();
+    };
+    const Test tests[] = {
+        { "slot map reuse", TestSlotMapReuse },
+        { "refired projectile handles", TestRefiredProjectileHandles },
+    };
+
+    int failed = 0;
+    for (const Test& test : tests) {
+        try {
+            test.function();
+            std::cout << "PASS " << test.name << std::endl;
+        }
+        catch (std::exception &e) {
+            std::cerr << "FAIL " << test.name << ": " << e.what() << std::endl;
+            failed++;
+        }
+    }
+    return failed == 0 ? 0 : -1;
+}